@@ -7,26 +7,52 @@
  */
 
 #include "RunCam.h"
+#include "core/timer/VirtualClock.h"
 #include "native/fakeArduino.h"
+#include <iterator>
 
 namespace obd::camera {
 
 constexpr uint8_t RC_HEADER               = 0xCC;   ///< runCam protocol header
 constexpr uint64_t ResponseTimeout        = 500;    ///< Timeout for message reception
 constexpr uint64_t ConnexionCheckInterval = 5000000;///< interval between 2 checks for device 5 seconds
+constexpr uint64_t PollInterval           = 10000;  ///< Time between two reads of the device at init
+constexpr int DeviceInfoLength            = 5;      ///< Length of the device information answer (header, 3 bytes, crc)
 
 void RunCam::init() {
     Node::init();
+    // run to check the connexion, or when the device talks
+    setSchedule(0, 500);
+    setWakeups(core::driver::Wakeup::Message | core::driver::Wakeup::Io);
+    stopTimer(checkTimer);
+    checkTimer = startTimer(ConnexionCheckInterval, ConnexionCheckInterval);
+}
+
+core::driver::InitStatus RunCam::initStep() {
+    switch (bootStep) {
+    case BootStep::Setup:
 #ifdef ARDUINO
-    uart.begin(115200);
-    uart.clearWriteError();
-    uart.flush();
+        uart.begin(115200);
+        uart.clearWriteError();
+        uart.flush();
 #endif
-    delay(10);
-    getDeviceInfo();
+        bootStep = BootStep::Query;
+        return retryIn(PollInterval);
+    case BootStep::Query:
+        startQuery();
+        bootStep = BootStep::Answer;
+        return retryIn(PollInterval);
+    case BootStep::Answer:
+        if (!answerQuery())
+            return retryIn(PollInterval);
+        break;
+    }
+    bootStep = BootStep::Setup;
+    init();
+    return initialized() ? core::driver::InitStatus::Done : core::driver::InitStatus::Failed;
 }
 
-OString RunCam::info() const {
+core::driver::Message::DataType RunCam::info() const {
     Message msg(0, 0);
     msg.println(F(" ----- RUNCAM INFORMATION -----"));
     msg.print(F("RunCam status: ......................... "));
@@ -78,20 +104,27 @@ OString RunCam::info() const {
 }
 
 void RunCam::preTreatment() {
+    // the device's bytes are the answer to the pending query
+    if (querying) {
+        if (!answerQuery())
+            return;
+        stopTimer(answerTimer);
+        if (answerTo != core::driver::unknownId)
+            broadcastMessage(Message{id(), answerTo, info(), Message::MessageType::Reply});
+        answerTo = core::driver::unknownId;
+    }
     // No actions during manual mode
     if (status == Status::MANUAL)
         return;
     // Check for the presence of the device
-    chrono += micros() - timestamp;
-    timestamp = micros();
-    if (chrono > ConnexionCheckInterval) {
-        chrono = 0;
+    if (timerExpired(checkTimer) > 0) {
         getDeviceInfo();
+        return;
     }
     // Print any remaining message from the device
 #ifdef ARDUINO
     if (uart.available() != 0) {
-        Message msg(type(),getConsoleId());
+        Message msg(id(),getConsoleId());
         while (uart.available() != 0) {
             int c = uart.read();
             if (debugPrint) {
@@ -100,63 +133,81 @@ void RunCam::preTreatment() {
         }
         if (debugPrint) {
             msg.println();
-            console(msg.getMessage());
+            console(msg.getMessage().str());
         }
     }
 #endif
 }
 
-bool RunCam::treatMessage(const Message& message) {
-    if (Node::treatMessage(message)) {
-        return true;
-    }
-    if (message.getType() == Message::MessageType::Command) {
-        if (message.getBaseCommand() == F("Debug")) {
-            debugPrint = !debugPrint;
-            return true;
-        }
-        if (message.getBaseCommand() == F("Test")) {
-            getDeviceInfo();
-            broadcastMessage(message.getSource(), info(), Message::MessageType::Reply);
-            return true;
-        }
-        if (message.getBaseCommand() == F("Cmd")) {
-            parseCmd(message.getParams()[0]);
-            return true;
-        }
-        if (message.getBaseCommand() == F("Menu")) {
-            parseMenu(message.getParams()[0]);
-            return true;
-        }
-    }
+bool RunCam::ioReady() {
+#ifdef ARDUINO
+    return uart.available() != 0;
+#else
     return false;
+#endif
 }
 
-bool RunCam::pushCommand(const Message& message) {
-    if (Node::pushCommand(message))
-        return true;
-    if (message.getBaseCommand() == F("Debug")) {
-        getMessages().push(message);
-        return true;
-    }
-    if (message.getBaseCommand() == F("Test")) {
-        getMessages().push(message);
-        return true;
-    }
-    if (message.getBaseCommand() == F("Cmd")) {
-        getMessages().push(message);
-        return true;
-    }
-    if (message.getBaseCommand() == F("Menu")) {
-        getMessages().push(message);
-        return true;
-    }
-    return false;
+core::driver::CommandTable RunCam::commands() const {
+    // in the CameraAction and MenuAction orders
+    static constexpr const char* actions[] = {"manual", "ctrl", "reset", "start", "stop"};
+    static_assert(std::size(actions) == static_cast<size_t>(CameraAction::Stop) + 1, "one keyword per camera action");
+    static constexpr const char* moves[] = {"open", "set", "left", "right", "up", "down"};
+    static_assert(std::size(moves) == static_cast<size_t>(MenuAction::Down) + 1, "one keyword per menu action");
+    static constexpr core::driver::CommandEntry table[] = {
+            {Commands::Debug, "Debug", 0, core::driver::commandHandler<&RunCam::cmdDebug>(), "Toggle the device's output printing", {}},
+            {Commands::Test, "Test", 0, core::driver::commandHandler<&RunCam::cmdTest>(), "Query the device and print its information", {}},
+            {Commands::Cmd, "Cmd", 1, core::driver::commandHandler<&RunCam::parseCmd>(), "<manual|ctrl|reset|start|stop> Control the camera", actions},
+            {Commands::Menu, "Menu", 1, core::driver::commandHandler<&RunCam::parseMenu>(), "<open|set|left|right|up|down> Navigate in the camera's menu", moves},
+    };
+    static_assert(core::driver::CommandTable::sorted(table), "commands must be sorted by id");
+    return table;
+}
+
+void RunCam::cmdDebug([[maybe_unused]] const Message& message) {
+    debugPrint = !debugPrint;
+}
+
+void RunCam::cmdTest(const Message& message) {
+    // replied once the device answered
+    answerTo = message.getSource();
+    getDeviceInfo();
 }
 
 void RunCam::getDeviceInfo() {
-    std::vector<uint8_t> response = sendCommand(Command::GET_DEVICE_INFO, std::vector<uint8_t>(), true);
-    Message msg{type(), 0, Message::MessageType::Reply};
+    if (querying)
+        return;
+    startQuery();
+    // wake up for the timeout if the device stays silent
+    answerTimer = startTimer(ResponseTimeout * 1000);
+}
+
+void RunCam::startQuery() {
+    writeCommand(Command::GET_DEVICE_INFO, {});
+    queryDate = core::timer::now();
+    querying  = true;
+}
+
+bool RunCam::answerQuery() {
+#ifdef ARDUINO
+    if (uart.available() < DeviceInfoLength) {
+        if (core::timer::now() - queryDate < ResponseTimeout * 1000)
+            return false;
+        if (uart.available() == 0) {
+            // Response timed out: there is maybe no device
+            querying = false;
+            status   = Status::DISCONNECTED;
+            applyDeviceInfo({});
+            return true;
+        }
+    }
+#endif
+    querying = false;
+    applyDeviceInfo(readResponse(Command::GET_DEVICE_INFO));
+    return true;
+}
+
+void RunCam::applyDeviceInfo(const std::vector<uint8_t>& response) {
+    Message msg{id(), 0, Message::MessageType::Reply};
     if (status == Status::DISCONNECTED) {
         msg.println("Camera Disconnected.");
         broadcastMessage(msg);
@@ -183,11 +234,11 @@ void RunCam::getDeviceInfo() {
     broadcastMessage(msg);
 }
 
-std::vector<uint8_t> RunCam::sendCommand(Command cmd, const std::vector<uint8_t>& params, bool expectResponse) {
+bool RunCam::writeCommand(Command cmd, const std::vector<uint8_t>& params) {
     // Only the get info command is allowed if not connected: it allow to determine if the device is connected
     if (status == Status::DISCONNECTED && (cmd != Command::GET_DEVICE_INFO)) {
-        console(F("RunCam sendCommand: no connexion for this command."), MessageType::Error);
-        return {};
+        console(F("RunCam writeCommand: no connexion for this command."), MessageType::Error);
+        return false;
     }
     // creation of the message to send
     std::vector<uint8_t> full_message;
@@ -205,22 +256,11 @@ std::vector<uint8_t> RunCam::sendCommand(Command cmd, const std::vector<uint8_t>
     // Effective message send
     uart.write(full_message.data(), full_message.size());
 #endif
-    full_message.clear();
-    if (!expectResponse)
-        return {};
-    // wait for a response
-    delay(10);// wait a little bit
-#ifdef ARDUINO
-    uint64_t start = millis();
-    while (uart.available() == 0) {
-        if (millis() - start > ResponseTimeout) {
-            // Response timed out: there is maybe no device
-            status = Status::DISCONNECTED;
-            return std::vector<uint8_t>();
-        }
-        delay(10);// 10ms
-    }
-#endif
+    return true;
+}
+
+std::vector<uint8_t> RunCam::readResponse(Command cmd) {
+    std::vector<uint8_t> full_message;
     // read the message
     resetCrc();
 #ifdef ARDUINO
@@ -229,12 +269,9 @@ std::vector<uint8_t> RunCam::sendCommand(Command cmd, const std::vector<uint8_t>
     while (uart.available() != 0) {
         uint8_t c = uart.read();
         if (!msg) {
-            if (c == RC_HEADER) {
-                msg = true;
-            } else {
-                delay(10);
+            if (c != RC_HEADER)
                 continue;
-            }
+            msg = true;
             crc8_dvb_s2(c);
             continue;
         }
@@ -244,11 +281,10 @@ std::vector<uint8_t> RunCam::sendCommand(Command cmd, const std::vector<uint8_t>
         }
         crc8_dvb_s2(c);
         full_message.push_back(c);
-        delay(10);// Slow down a bit the reading!
     }
     // Message verification
     if (!valid) {
-        console(F("RunCam sendCommand: bad CRC."));
+        console(F("RunCam readResponse: bad CRC."));
         return {};
     }
 #endif
@@ -256,8 +292,8 @@ std::vector<uint8_t> RunCam::sendCommand(Command cmd, const std::vector<uint8_t>
     if (cmd == Command::GET_DEVICE_INFO && status == Status::DISCONNECTED)
         status = Status::READY;
     if (debugPrint) {
-        Message msag(type(), 0, MessageType::Reply);
-        msag.print(F("RunCam sendCommand message: "));
+        Message msag(id(), 0, MessageType::Reply);
+        msag.print(F("RunCam readResponse message: "));
         for (auto insideChar : full_message) {
             msag.print(insideChar, Message::Format::Hexadecimal);
             msag.print(" ");
@@ -269,37 +305,56 @@ std::vector<uint8_t> RunCam::sendCommand(Command cmd, const std::vector<uint8_t>
     return full_message;
 }
 
-void RunCam::parseCmd(const OString& cmd) {
-    if (cmd == F("manual")) {
+void RunCam::parseCmd(const Message& message) {
+    const core::driver::Command& cmd = message.getCommand();
+    if (!cmd.validArgument()) {
+        console(F("Unknown Camera Command"), MessageType::Error);
+        return;
+    }
+    switch (static_cast<CameraAction>(cmd.argument)) {
+    case CameraAction::Manual:
         setManual();
-    } else if (cmd == F("ctrl")) {
+        break;
+    case CameraAction::Ctrl:
         unsetManual();
-    } else if (cmd == F("reset")) {
+        break;
+    case CameraAction::Reset:
         resetState();
-    } else if (cmd == F("start")) {
+        break;
+    case CameraAction::Start:
         startRecording();
-    } else if (cmd == F("stop")) {
+        break;
+    case CameraAction::Stop:
         stopRecording();
-    } else {
-        console(F("Unknown Camera Command"), MessageType::Error);
+        break;
     }
 }
 
-void RunCam::parseMenu(const OString& cmd) {
-    if (cmd == F("open")) {
+void RunCam::parseMenu(const Message& message) {
+    const core::driver::Command& cmd = message.getCommand();
+    if (!cmd.validArgument()) {
+        console(F("Unknown Menu Command"), Message::MessageType::Error);
+        return;
+    }
+    switch (static_cast<MenuAction>(cmd.argument)) {
+    case MenuAction::Open:
         openMenu();
-    } else if (cmd == F("set")) {
+        break;
+    case MenuAction::Set:
         moveSet();
-    } else if (cmd == F("left")) {
+        break;
+    case MenuAction::Left:
         moveLeft();
-    } else if (cmd == F("right")) {
+        break;
+    case MenuAction::Right:
         moveRight();
-    } else if (cmd == F("up")) {
+        break;
+    case MenuAction::Up:
         moveUp();
-    } else if (cmd == F("down")) {
+        break;
+    case MenuAction::Down:
         moveDown();
-    } else {
-        console(F("Unknown Menu Command"), Message::MessageType::Error);
+        break;
     }
 }
 
@@ -325,10 +380,10 @@ void RunCam::startRecording() {
     if (status != Status::READY)
         return;
     if (DeviceInfo.hasFeature(Feature::START_RECORDING)) {
-        sendCommand(Command::CAMERA_CONTROL, {static_cast<uint8_t>(ControlCommand::CHANGE_START_RECORDING)}, false);
+        writeCommand(Command::CAMERA_CONTROL, {static_cast<uint8_t>(ControlCommand::CHANGE_START_RECORDING)});
         status = Status::RECORDING;
     } else if (DeviceInfo.hasFeature(Feature::SIMULATE_POWER_BUTTON)) {
-        sendCommand(Command::CAMERA_CONTROL, {static_cast<uint8_t>(ControlCommand::SIMULATE_POWER_BTN)}, false);
+        writeCommand(Command::CAMERA_CONTROL, {static_cast<uint8_t>(ControlCommand::SIMULATE_POWER_BTN)});
         status = Status::RECORDING;
     }
 }
@@ -337,16 +392,10 @@ void RunCam::stopRecording() {
     if (status != Status::RECORDING)
         return;
     if (DeviceInfo.hasFeature(Feature::STOP_RECORDING)) {
-        sendCommand(
-                Command::CAMERA_CONTROL,
-                {static_cast<uint8_t>(ControlCommand::CHANGE_STOP_RECORDING)},
-                false);
+        writeCommand(Command::CAMERA_CONTROL, {static_cast<uint8_t>(ControlCommand::CHANGE_STOP_RECORDING)});
         status = Status::READY;
     } else if (DeviceInfo.hasFeature(Feature::SIMULATE_POWER_BUTTON)) {
-        sendCommand(
-                Command::CAMERA_CONTROL,
-                {static_cast<uint8_t>(ControlCommand::SIMULATE_POWER_BTN)},
-                false);
+        writeCommand(Command::CAMERA_CONTROL, {static_cast<uint8_t>(ControlCommand::SIMULATE_POWER_BTN)});
         status = Status::READY;
     }
 }
@@ -355,15 +404,12 @@ void RunCam::openMenu() {
     if (status != Status::READY)
         return;
     if (!DeviceInfo.hasFeature(Feature::CHANGE_MODE)) {
-        sendCommand(Command::CAMERA_CONTROL,
-                    {static_cast<uint8_t>(ControlCommand::CHANGE_MODE)},
-                    false);
+        writeCommand(Command::CAMERA_CONTROL, {static_cast<uint8_t>(ControlCommand::CHANGE_MODE)});
         status = Status::MENU;
         navMenu.enterMenu();
     } else if (DeviceInfo.hasFeature(Feature::SIMULATE_5_KEY_OSD_CABLE)) {
-        sendCommand(
-                Command::KEY5_SIMULATION_PRESS,
-                {static_cast<uint8_t>(NavDirection::Enter)});
+        // the acknowledgement is read by preTreatment, without waiting for it
+        writeCommand(Command::KEY5_SIMULATION_PRESS, {static_cast<uint8_t>(NavDirection::Enter)});
         status = Status::MENU;
         navMenu.enterMenu();
     }
@@ -395,9 +441,8 @@ void RunCam::moveMenu(const NavDirection& dir) {
         return;
     }
     if (DeviceInfo.hasFeature(Feature::SIMULATE_5_KEY_OSD_CABLE)) {
-        sendCommand(
-                Command::KEY5_SIMULATION_PRESS,
-                {static_cast<uint8_t>(dir)});
+        // the acknowledgement is read by preTreatment, without waiting for it
+        writeCommand(Command::KEY5_SIMULATION_PRESS, {static_cast<uint8_t>(dir)});
         if (navMenu.moveMenu(dir))
             status = Status::READY;
     } else {
@@ -20,6 +20,16 @@ namespace obd::camera {
  */
 class RunCam : public core::driver::Node {
 public:
+    /**
+     * @brief Ids of the camera's own commands
+     */
+    struct Commands {
+        static constexpr CommandId Debug = core::driver::nodeCommand(0);///< Toggle the output printing
+        static constexpr CommandId Test = core::driver::nodeCommand(1);///< Query the device
+        static constexpr CommandId Cmd = core::driver::nodeCommand(2);///< Control the camera
+        static constexpr CommandId Menu = core::driver::nodeCommand(3);///< Navigate in the menu
+    };
+
     /**
      * @brief Possible Status of the camera
      */
@@ -35,28 +45,27 @@ public:
      * @param parent The parent system
      */
     explicit RunCam(const std::shared_ptr<Messenger>& parent = nullptr) :
-        Node(parent){};
+        Node(parent, queueStorage) {}
 
     /**
-     * @brief Initialize file system
+     * @brief Initialize the node, the device is brought up by initStep()
      */
     void init() override;
 
     /**
-     * @brief Return the driver infos
-     * @return The driver's infos.
+     * @brief Bring the device up without blocking: open the link, query the device, wait for its answer
+     * @return Pending until the device answered or timed out
      */
-    [[nodiscard]] OString info()const override;
+    core::driver::InitStatus initStep() override;
 
     /**
-     * @brief Try to treat the given command
-     * @param message The command to treat
-     * @return True if the command treated
+     * @brief Return the driver infos
+     * @return The driver's infos.
      */
-    bool treatMessage(const Message& message) override;
+    [[nodiscard]] Message::DataType info()const override;
 
     /**
-     * @brief Retrieve infos from device
+     * @brief Ask the device its information, the answer is read by the next updates
      */
     void getDeviceInfo();
 
@@ -115,13 +124,10 @@ public:
      */
     void moveDown();
 
-    /**
-     * @brief Append some time to the chronometer
-     * @param addedTime The time to add
-     */
-    void accelerateTime(uint64_t addedTime);
-
 private:
+    /// Storage of the message queue
+    QueueStorage<config::cameraQueueLength> queueStorage;
+
     /**
      * @brief List of RunCam device protocol supported functions
      */
@@ -133,6 +139,15 @@ private:
         KEY5_CONNECTION         = 0x04,///< Send handshake events and disconnected events to the camera
     };
 
+    /**
+     * @brief Steps of the device bring-up
+     */
+    enum struct BootStep : uint8_t {
+        Setup, ///< Open the link
+        Query, ///< Ask the device information
+        Answer,///< Wait for the device's answer
+    };
+
     /**
      * @brief List of device features
      */
@@ -159,6 +174,29 @@ private:
         CHANGE_STOP_RECORDING  = 0x04,///< Control the camera to stop recording
     };
 
+    /**
+     * @brief Arguments of the 'Cmd' command (keyword order of the command table)
+     */
+    enum struct CameraAction : uint8_t {
+        Manual,///< Switch to manual mode
+        Ctrl,  ///< Back to controlled mode
+        Reset, ///< Reset the camera state
+        Start, ///< Start recording
+        Stop,  ///< Stop recording
+    };
+
+    /**
+     * @brief Arguments of the 'Menu' command (keyword order of the command table)
+     */
+    enum struct MenuAction : uint8_t {
+        Open, ///< Open the menu
+        Set,  ///< Validate
+        Left, ///< Move left
+        Right,///< Move right
+        Up,   ///< Move up
+        Down, ///< Move down
+    };
+
     /**
      * @brief Information about camera
      */
@@ -175,8 +213,6 @@ private:
             return (Features & (1U << static_cast<uint8_t>(feature))) != 0;
         }
     } DeviceInfo;
-    /// Internal timestamp
-    uint64_t timestamp = 0;
 
     /// Current status of the camera
     Status status = Status::DISCONNECTED;
@@ -187,8 +223,23 @@ private:
     /// Current message crc
     uint8_t current_crc = 0;
 
-    /// internal chronometer
-    uint64_t chrono = 0;
+    /// Timer of the connexion check
+    TimerId checkTimer = core::timer::TimerService::invalidTimer;
+
+    /// Next step of the device bring-up
+    BootStep bootStep = BootStep::Setup;
+
+    /// Timer of the device's answer timeout
+    TimerId answerTimer = core::timer::TimerService::invalidTimer;
+
+    /// Date of the device query
+    uint64_t queryDate = 0;
+
+    /// If the device query waits for its answer
+    bool querying = false;
+
+    /// Node waiting for the information once the device answered
+    core::driver::NodeId answerTo = core::driver::unknownId;
 
 
 #ifdef ARDUINO
@@ -205,20 +256,62 @@ private:
     void preTreatment() override;
 
     /**
-     * @brief Send command with its parameters, wait for response
+     * @brief Check for bytes sent by the device
+     * @return True if the UART has data
+     */
+    [[nodiscard]] bool ioReady() override;
+
+    /**
+     * @brief Send command with its parameters, without waiting for the device
+     *
+     * The device's answers are read by preTreatment when the UART has data.
      * @param cmd The command to send
      * @param params The list of parameter
-     * @param expectResponse Do we expect a response
+     * @return False if the device is not connected
+     */
+    bool writeCommand(Command cmd, const std::vector<uint8_t>& params);
+
+    /**
+     * @brief Read the response of the device
+     * @param cmd The command sent
      * @return The content of the response
      */
-    std::vector<uint8_t> sendCommand(Command cmd, const std::vector<uint8_t>& params, bool expectResponse = true);
+    std::vector<uint8_t> readResponse(Command cmd);
+
+    /**
+     * @brief Send the device information query
+     */
+    void startQuery();
+
+    /**
+     * @brief Read the answer to the device query once arrived, or give up after the timeout
+     * @return False while waiting for the answer
+     */
+    bool answerQuery();
+
+    /**
+     * @brief Store and report the device information
+     * @param response The response to the information request
+     */
+    void applyDeviceInfo(const std::vector<uint8_t>& response);
+
+    /**
+     * @brief Get the camera commands
+     * @return The command table
+     */
+    [[nodiscard]] core::driver::CommandTable commands() const override;
+
+    /**
+     * @brief Command 'Debug': toggle the printing of the device's bytes
+     * @param message The command
+     */
+    void cmdDebug(const Message& message);
 
     /**
-     * @brief Send a message to this driver
-     * @param message The Command message to send
-     * @return True mean command caught.
+     * @brief Command 'Test': query the device and reply its information
+     * @param message The command
      */
-    bool pushCommand(const Message& message)override;
+    void cmdTest(const Message& message);
     /**
      * @brief Reset the current crc code
      */
@@ -234,16 +327,16 @@ private:
     }
 
     /**
-     * @brief Parse a command string into an instruction and send it to camera
-     * @param cmd The command string to parse
+     * @brief Command 'Cmd': convert into an instruction and send it to camera
+     * @param message The command
      */
-    void parseCmd(const OString& cmd);
+    void parseCmd(const Message& message);
 
     /**
-     * @brief Parse a command string into a menu movement
-     * @param cmd The command string to parse
+     * @brief Command 'Menu': convert into a menu movement
+     * @param message The command
      */
-    void parseMenu(const OString& cmd);
+    void parseMenu(const Message& message);
 
     /**
      * @brief Generic function to move into the menu
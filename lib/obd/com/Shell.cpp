@@ -8,17 +8,91 @@
 
 #include "Shell.h"
 #include "core/driver/Messenger.h"
+#include "native/fakeArduino.h"
 #ifdef ESP8266
 #include <core_esp8266_features.h>
 #endif
 namespace obd::com {
 
-void Shell::addOutput(size_t hcd) {
-    outputs.insert(hcd);
+namespace {
+
+/**
+ * @brief Print the execution times of a phase as min/avg/max/p99
+ * @param msg The message to fill
+ * @param label The phase's name
+ * @param histogram The execution times
+ */
+void printHistogram(core::driver::Message& msg, const char* label, const core::driver::Histogram& histogram) {
+    msg.print(label);
+    msg.print(histogram.min());
+    msg.print("/");
+    msg.print(histogram.average());
+    msg.print("/");
+    msg.print(histogram.max());
+    msg.print("/");
+    msg.print(histogram.percentile(99));
+}
+
+/**
+ * @brief Print a memory usage as live/peak and allocation count
+ * @param msg The message to fill
+ * @param usage The memory usage
+ */
+void printUsage(core::driver::Message& msg, const core::memory::Usage& usage) {
+    msg.print(" ");
+    msg.print(usage.live);
+    msg.print("/");
+    msg.print(usage.peak);
+    msg.print(" allocs ");
+    msg.print(usage.allocations);
+}
+
+/// Argument keyword of 'dlq'
+constexpr const char* clearArgument[]{"clear"};
+
+/// Argument keyword of 'top' and 'mem'
+constexpr const char* resetArgument[]{"reset"};
+
+/**
+ * @brief Check if the parameter of a shell command is one of its keywords
+ * @param message The command
+ * @param arguments The command's keywords
+ * @return True if known keyword
+ */
+bool knownArgument(const core::driver::Message& message, const core::driver::ArgumentList& arguments) {
+    return arguments.find(message.getWords(1)[0]) != core::driver::Command::unknownArgument;
 }
 
-void Shell::removeOutput(size_t hcd) {
-    outputs.erase(hcd);
+/// Topics of the console messages, received by the outputs
+constexpr core::driver::Topic consoleTopics[]{core::driver::Topic::Log, core::driver::Topic::Warning, core::driver::Topic::Error};
+
+/**
+ * @brief Get the console topic of a message type
+ * @param type The message's type
+ * @return The topic
+ */
+core::driver::Topic topicOf(const core::driver::Message::MessageType& type) {
+    switch (type) {
+    case core::driver::Message::MessageType::Error:
+        return core::driver::Topic::Error;
+    case core::driver::Message::MessageType::Warning:
+        return core::driver::Topic::Warning;
+    default:
+        break;
+    }
+    return core::driver::Topic::Log;
+}
+
+}// namespace
+
+void Shell::addOutput(NodeId hcd) {
+    for (const auto& topic : consoleTopics)
+        getMessenger()->subscribe(hcd, topic);
+}
+
+void Shell::removeOutput(NodeId hcd) {
+    for (const auto& topic : consoleTopics)
+        getMessenger()->unsubscribe(hcd, topic);
 }
 
 bool Shell::treatMessage(const Message& message) {
@@ -30,44 +104,61 @@ bool Shell::treatMessage(const Message& message) {
         return true;
     }
     if (message.getType() == MessageType::Input) {
-        outputMessage(message.getMessage(), MessageType::Message);// echo message
+        outputMessage(Message{id(), 0, message.getMessage(), MessageType::Message});// echo message
+        // the words after the tokenizer's capacity would be lost
+        if (message.isTruncated()) {
+            outputMessage(F("Too many words in the command."), MessageType::Error);
+            return true;
+        }
         // check for a shell command
         if (shellCommand(message))
             return true;
-        size_t nodeId = getMessenger()->computeId(message.getBaseCommand());
-        if (nodeId != 0) {
+        NodeId nodeId = getMessenger()->computeId(message.getBaseCommand());
+        if (nodeId != core::driver::unknownId && nodeId != core::driver::broadcastId) {
             if (message.hasParams()) {
-                broadcastMessage(nodeId, message.getParamStr(), MessageType::Command);
+                broadcastMessage(Message{id(), nodeId, message.getParamStr(data::Arena::current()).c_str(), MessageType::Command});
             }else{
                 outputMessage(F("Driver name alone need a command."), MessageType::Error);
             }
             return true;
         }
     }
-    outputMessage(Message{type(),0,F("Unknown command"), MessageType::Error});// echo message
+    outputMessage(Message{id(),0,F("Unknown command"), MessageType::Error});// echo message
     return false;
 }
 
 void Shell::outputMessage(const core::driver::Message& message) {
-    for(const auto& output : outputs){
-        broadcastMessage(Message{message.getSource(), output, message.getMessage(), message.getType()});
-    }
+    // one message for all the outputs, keeping the original source
+    broadcastMessage(Message{message.getSource(), topicOf(message.getType()), message.getMessage(), message.getType()});
 }
 
 void Shell::outputMessage(const OString& message, const core::driver::Node::MessageType& messageType) {
-    outputMessage(Message{type(),0,message, messageType});
+    outputMessage(Message{id(),0,message, messageType});
 }
 
 bool Shell::shellCommand([[maybe_unused]]const core::driver::Message& message) {
-    if (message.getBaseCommand() == F("dmesg")){
+    switch (message.getCommand().id) {
+    case CommandId::Dmesg:
         dmesg();
         return true;
-    }
-    if (message.getBaseCommand() == F("lsdrv")){
+    case CommandId::Lsdrv:
         lsdrv();
         return true;
+    case CommandId::Help:
+        help(message);
+        return true;
+    case CommandId::Dlq:
+        deadLetters(message);
+        return true;
+    case CommandId::Top:
+        top(message);
+        return true;
+    case CommandId::Mem:
+        mem(message);
+        return true;
+    default:
+        return false;
     }
-    return false;
 }
 
 void Shell::dmesg() {
@@ -77,10 +168,129 @@ void Shell::dmesg() {
 
 #endif
 #else
-    output
+    outputMessage(F("System native"), MessageType::Message);
 #endif
 }
 
+void Shell::help(const core::driver::Message& message) {
+    if (!message.getCommand().hasArgument()) {
+        lsdrv();
+        return;
+    }
+    NodeId nodeId = getMessenger()->computeId(OString{message.getWords(1)[0]});
+    if (nodeId == core::driver::unknownId || nodeId == core::driver::broadcastId) {
+        outputMessage(F("help: unknown driver"), MessageType::Error);
+        return;
+    }
+    broadcastMessage(Message{id(), nodeId, core::driver::Command{CommandId::Help}});
+}
+
+void Shell::deadLetters(const core::driver::Message& message) {
+    auto& messenger = getMessenger();
+    if (message.getCommand().hasArgument()) {
+        if (knownArgument(message, clearArgument)) {
+            messenger->clearDeadLetters();
+        } else {
+            outputMessage(F("dlq: unknown parameter"), MessageType::Error);
+        }
+        return;
+    }
+    const auto& letters = messenger->deadLetters();
+    outputMessage(F("Undelivered messages"), MessageType::Message);
+    for (size_t idx = 0; idx < letters.size(); ++idx) {
+        const auto& letter = letters[idx];
+        Message msg{id(), 0};
+        msg.print(messenger->computeName(letter.message.getSource()));
+        msg.print(" -> ");
+        msg.print(messenger->computeName(letter.recipient != core::driver::unknownId ? letter.recipient : letter.message.getDestination()));
+        switch (letter.reason) {
+        case core::driver::Delivery::Status::Accepted:
+            break;
+        case core::driver::Delivery::Status::Saturated:
+            msg.print(" [saturated] ");
+            break;
+        case core::driver::Delivery::Status::Refused:
+            msg.print(" [refused] ");
+            break;
+        case core::driver::Delivery::Status::Unreachable:
+            msg.print(" [unreachable] ");
+            break;
+        }
+        msg.print(letter.message.getMessage().c_str());
+        outputMessage(msg);
+    }
+}
+
+void Shell::top(const core::driver::Message& message) {
+    auto& messenger = getMessenger();
+    size_t count    = messenger->getDriverCount();
+    if (message.getCommand().hasArgument()) {
+        if (!knownArgument(message, resetArgument)) {
+            outputMessage(F("top: unknown parameter"), MessageType::Error);
+            return;
+        }
+        for (size_t nodeId = 1; nodeId <= count; ++nodeId)
+            messenger->getDriver(static_cast<NodeId>(nodeId))->resetProfile();
+        return;
+    }
+    outputMessage(F("Execution times in us (min/avg/max/p99)"), MessageType::Message);
+    for (size_t nodeId = 1; nodeId <= count; ++nodeId) {
+        const auto* node    = messenger->getDriver(static_cast<NodeId>(nodeId));
+        const auto& profile = node->profile();
+        Message msg{id(), 0};
+        msg.print(node->name());
+        msg.print(" runs ");
+        msg.print(node->schedule().runs);
+        msg.print(" overruns ");
+        msg.print(node->schedule().overruns);
+        printHistogram(msg, " pre ", profile.preTreatment);
+        printHistogram(msg, " msg ", profile.messages);
+        printHistogram(msg, " post ", profile.postTreatment);
+        outputMessage(msg);
+    }
+}
+
+void Shell::mem(const core::driver::Message& message) {
+    using core::memory::Tracker;
+    auto& messenger = getMessenger();
+    size_t count    = messenger->getDriverCount();
+    if (message.getCommand().hasArgument()) {
+        if (!knownArgument(message, resetArgument)) {
+            outputMessage(F("mem: unknown parameter"), MessageType::Error);
+            return;
+        }
+        Tracker::resetPeaks();
+        return;
+    }
+    outputMessage(F("Heap in bytes (live/peak)"), MessageType::Message);
+    Message system{id(), 0};
+    system.print("system");
+    printUsage(system, Tracker::usage(0));
+    outputMessage(system);
+    for (size_t nodeId = 1; nodeId <= count; ++nodeId) {
+        const auto* node = messenger->getDriver(static_cast<NodeId>(nodeId));
+        Message msg{id(), 0};
+        msg.print(node->name());
+        printUsage(msg, node->memoryUsage());
+        outputMessage(msg);
+    }
+    Message total{id(), 0};
+    total.print("total");
+    printUsage(total, Tracker::total());
+    outputMessage(total);
+    if (Tracker::freeHeap() == 0)
+        return;
+    Message heap{id(), 0};
+    heap.print("heap free ");
+    heap.print(static_cast<uint32_t>(Tracker::freeHeap()));
+    heap.print(" lowest ");
+    heap.print(static_cast<uint32_t>(Tracker::lowestFreeHeap()));
+    heap.print(" fragmentation ");
+    heap.print(Tracker::fragmentation());
+    heap.print("%");
+    outputMessage(heap);
+}
+
 void Shell::lsdrv() {
     auto list = getMessenger()->getDriverList();
     outputMessage(F("List of drivers"), MessageType::Message);
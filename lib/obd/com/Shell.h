@@ -7,7 +7,6 @@
  */
 
 #pragma once
-#include <unordered_set>
 #include "core/driver/Node.h"
 
 namespace obd::com {
@@ -21,7 +20,9 @@ public:
      * @brief Default constructor.
      * @param parent The link to the messenger system
      */
-    explicit Shell(std::shared_ptr<Messenger> parent):Node{std::move(parent)}{}
+    explicit Shell(std::shared_ptr<Messenger> parent):Node{std::move(parent), queueStorage}{
+        setWakeups(core::driver::Wakeup::Message);
+    }
 
     /**
      * @brief Get the node's category
@@ -30,20 +31,20 @@ public:
     [[nodiscard]] Category category() const final { return Category::Console; }
 
     /**
-     * @brief Add an output to the list
-     * @param hcd The output's hashcode
+     * @brief Add an output: subscribe it to the console topics
+     * @param hcd The output's node id
      */
-    void addOutput(size_t hcd);
+    void addOutput(NodeId hcd);
 
     /**
-     * @brief Remove an output of the list
-     * @param hcd The output's hashcode
+     * @brief Remove an output: unsubscribe it from the console topics
+     * @param hcd The output's node id
      */
-    void removeOutput(size_t hcd);
+    void removeOutput(NodeId hcd);
 
 private:
-    /// List of Output com nodes ids.
-    std::unordered_set<size_t> outputs;
+    /// Storage of the message queue
+    QueueStorage<config::shellQueueLength> queueStorage;
 
     void outputMessage(const Message& message);
 
@@ -56,5 +57,13 @@ private:
     void dmesg();
 
     void lsdrv();
+
+    void help(const Message& message);
+
+    void deadLetters(const Message& message);
+
+    void top(const Message& message);
+
+    void mem(const Message& message);
 };
 }// namespace obd::com
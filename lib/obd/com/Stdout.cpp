@@ -15,7 +15,14 @@
 
 namespace obd::com {
 
-void Stdout::writeLine(const OString& line) {
+void Stdout::write(const char* text) {
+#ifdef ARDUINO
+    Serial.print(text);
+#else
+    std::cout << text;
+#endif
+}
+void Stdout::writeLine(const char* line) {
 #ifdef ARDUINO
     Serial.println(line);
 #else
@@ -29,7 +29,9 @@ private:
 
     OString readLine()override;
 
-    void writeLine(const OString& line)override;
+    void write(const char* text)override;
+
+    void writeLine(const char* line)override;
 };
 
 }// namespace obd::com
@@ -36,16 +36,19 @@ bool ComNode::treatMessage(const core::driver::Message& message) {
         return true;
     }
     if (message.isMessage()){
-        OString affichage;
-        affichage += computeName(message.getSource()) + " > ";
+        // frame temporary
+        data::ArenaString affichage{data::ArenaAllocator<char>{data::Arena::current()}};
+        affichage += computeName(message.getSource()).c_str();
+        affichage += " > ";
         if (message.getType() == MessageType::Error){
             affichage += "ERROR ";
         }
         if (message.getType() == MessageType::Warning){
             affichage += "WARNING ";
         }
-        affichage += message.getMessage();
-        writeLine(affichage);
+        write(affichage.c_str());
+        // the text may be shared with other outputs: written without copy
+        writeLine(message.getMessage().c_str());
         return true;
     }
     return false;
@@ -23,7 +23,10 @@ public:
      * @param parent The parent system
      */
     explicit ComNode(std::shared_ptr<Messenger> parent) :
-        Node{std::move(parent)} {}
+        Node{std::move(parent), queueStorage} {
+        // run only to print messages or read input
+        setWakeups(core::driver::Wakeup::Message | core::driver::Wakeup::Io);
+    }
 
     /**
      * @brief Get the node's category
@@ -32,6 +35,9 @@ public:
     [[nodiscard]] Category category() const final { return Category::Communicator; }
 
 private:
+    /// Storage of the message queue
+    QueueStorage<config::comQueueLength> queueStorage;
+
     /**
      * @brief What to do before message treatment
      */
@@ -42,6 +48,12 @@ private:
      */
     void postTreatment() final;
 
+    /**
+     * @brief Check for input to read
+     * @return True if a line is available
+     */
+    [[nodiscard]] bool ioReady() final { return available(); }
+
     /**
      * @brief Treat the given message
      * @param message The message to treat
@@ -57,6 +69,8 @@ private:
 
     virtual OString readLine(){return {};}
 
-    virtual void writeLine([[maybe_unused]] const OString& line){}
+    virtual void write([[maybe_unused]] const char* text){}
+
+    virtual void writeLine([[maybe_unused]] const char* line){}
 };
 }// namespace obd::com::base
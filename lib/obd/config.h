@@ -7,6 +7,8 @@
  */
 
 #pragma once
+#include <array>
+#include <cstddef>
 #include <cstdint>
 
 /**
@@ -26,4 +28,88 @@ constexpr char tsSave[]{"/dev/time"};
 /// interval between 2 save of the timestamp
 constexpr uint64_t saveInterval = 60000000;
 
+/// Number of priority lanes in the messenger
+constexpr size_t messengerLaneCount = 4;
+
+/// Capacity of each priority lane of the messenger, from the most urgent one (powers of two)
+constexpr std::array<size_t, messengerLaneCount> messengerLaneLengths{16, 8, 8, 16};
+
+/// Messages delivered at least each frame for each lane, from the most urgent one
+constexpr std::array<uint8_t, messengerLaneCount> messengerLaneBudgets{4, 3, 2, 1};
+
+/// Default number of frames a message is offered to a saturated node before giving up
+constexpr uint8_t deliveryAttempts = 3;
+
+/// Number of undelivered messages kept for inspection
+constexpr size_t deadLetterLength = 8;
+
+/// Default worst-case execution time declared by a node, in microseconds
+constexpr uint64_t nodeBudget = 1000;
+
+/// Time allowed to the nodes in one frame, in microseconds (the rest is left to the network, display...)
+constexpr uint64_t frameBudget = 10000;
+
+/// Longest sleep of the main loop when no node is ready, in microseconds
+constexpr uint64_t maxIdleTime = 10000;
+
+/// Longest sleep of the main loop when a node waits for input, in microseconds
+constexpr uint64_t ioPollPeriod = 2000;
+
+/// Resolution of the timer service, in microseconds
+constexpr uint64_t timerTick = 1000;
+
+/// Maximum number of timers running at the same time
+constexpr uint8_t timerCount = 16;
+
+/// Number of buckets of the execution time histograms (the last one holds everything above 2^22 us)
+constexpr uint8_t profileBuckets = 24;
+
+/// Number of memory owners tracked separately: no node, then the node ids (the last slot is shared)
+constexpr uint8_t memoryOwners = 16;
+
+/// Size of the arena for the temporaries of one frame, in bytes
+constexpr size_t frameArenaSize = 2048;
+
+/// Size of the default buffer of a text file, in bytes
+constexpr size_t fileBufferSize = 256;
+
+/// Number of paths whose type and size are remembered by the filesystem
+constexpr uint8_t statCacheLength = 8;
+
+/// Capacity of the message queue of the nodes not choosing their own (a power of two)
+constexpr size_t nodeQueueLength = 16;
+
+/// Capacity of the message queue of the status led
+constexpr size_t ledQueueLength = 4;
+
+/// Capacity of the message queue of the shell
+constexpr size_t shellQueueLength = 8;
+
+/// Capacity of the message queue of the communication nodes (every console message goes through them)
+constexpr size_t comQueueLength = 8;
+
+/// Capacity of the message queue of the clock
+constexpr size_t clockQueueLength = 4;
+
+/// Capacity of the message queue of the filesystem
+constexpr size_t fileSystemQueueLength = 4;
+
+/// Capacity of the message queue of the camera
+constexpr size_t cameraQueueLength = 4;
+
+/// Capacity of the message queue of the display
+constexpr size_t displayQueueLength = 4;
+
+/// Size of the text stored inside a message without any allocation
+constexpr uint16_t messageInlineLength = 64;
+
+/// Size of the blocks used for longer message's texts
+constexpr uint16_t payloadBlockSize = 1024;
+
+/// Number of blocks used for longer message's texts
+constexpr size_t payloadBlockCount = 4;
+
+/// Maximum number of words tracked in a command
+constexpr uint8_t maxCommandTokens = 6;
+
 }// namespace obd::config
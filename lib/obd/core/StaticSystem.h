@@ -0,0 +1,289 @@
+/**
+ * @file StaticSystem.h
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+
+#include "com/Shell.h"
+#include "data/Arena.h"
+#include "driver/Manager.h"
+#include "driver/Messenger.h"
+#include "memory/MemoryTracker.h"
+#include "native/fakeArduino.h"
+#include "timer/VirtualClock.h"
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <type_traits>
+
+namespace obd::core {
+
+/**
+ * @brief System whose node list is fixed at compile time
+ *
+ * The nodes live in a tuple inside the system: no allocation and no reference
+ * counting (the links between nodes, messenger and manager are non-owning
+ * pointers). A node is found by its type at compile time, and its id is
+ * its position in the list plus one. Each Communicator node becomes an output
+ * of the Shell, if the list contains one.
+ *
+ * The frame loop is generated from the list: the ready nodes are checked and
+ * run through their concrete types, without the manager's node vector, virtual
+ * update or reference counting. The manager still runs the initialization
+ * steps and the timers. The hooks inside a node (treatments, ioReady) stay
+ * virtual.
+ *
+ * The dynamic System stays available for the tests and for nodes added at runtime.
+ * @tparam Nodes The node's types, all different and derived from Node
+ */
+template<class... Nodes>
+class StaticSystem : public base::Object {
+    static_assert(sizeof...(Nodes) > 0, "a system needs nodes");
+    static_assert((std::is_base_of_v<driver::Node, Nodes> && ...), "only class derived from Node is allowed");
+
+public:
+    StaticSystem(const StaticSystem&) = delete;
+    StaticSystem(StaticSystem&&)      = delete;
+    StaticSystem& operator=(const StaticSystem&) = delete;
+    StaticSystem& operator=(StaticSystem&&) = delete;
+
+    /**
+     * @brief Default constructor: build the nodes in place
+     */
+    StaticSystem() :
+        messenger{unowned(manager)}, nodes{(static_cast<void>(sizeof(Nodes)), unowned(messenger))...},
+        bases{&std::get<Nodes>(nodes)...} {}
+
+    /**
+     * @brief Destructor.
+     */
+    ~StaticSystem() override = default;
+
+    /**
+     * @brief Initialisation: register the nodes in the list's order
+     */
+    void init() override {
+        Object::init();
+        messenger.init();
+        (manager.addNode(unowned<driver::Node>(std::get<Nodes>(nodes))), ...);
+        if constexpr (contains<com::Shell>()) {
+            for (auto* output : manager.categoryList(driver::Category::Communicator))
+                getNode<com::Shell>().addOutput(output->id());
+        }
+        manager.init();
+    }
+
+    /**
+     * @brief Actualization frame, sleep until the next event when no node is ready
+     *
+     * The frame arena is the current one during the frame, and reset at its end.
+     */
+    void update() override {
+        if (!initialized()) {
+            return;
+        }
+        data::ArenaScope frame{arena};
+        messenger.update();
+        runNodes(manager.startFrame());
+        if (messenger.size() > 0)
+            return;
+        timer::idle(idleTime());
+    }
+
+    /**
+     * @brief Get the time during which no node will be ready, if nothing else happens
+     * @return The idle time in microseconds (0 if a node is ready)
+     */
+    [[nodiscard]] uint64_t idleTime() {
+        uint64_t now  = timer::now();
+        auto& timers  = manager.timerService();
+        // the expired timers wake their nodes up
+        timers.advance(now);
+        uint64_t idle = std::min(config::maxIdleTime, timers.idleTime());
+        for (auto* node : bases) {
+            if (node->nodeInitState == driver::InitState::Pending)
+                idle = std::min(idle, node->initRetry > now ? node->initRetry - now : 0);
+            if (!node->initialized())
+                continue;
+            if (node->hasWork(now))
+                return 0;
+            const driver::Schedule& schedule = node->nodeSchedule;
+            if (driver::hasWakeup(schedule.wakeups, driver::Wakeup::Timer))
+                idle = std::min(idle, schedule.deadline - now);
+            if (driver::hasWakeup(schedule.wakeups, driver::Wakeup::Io))
+                idle = std::min(idle, config::ioPollPeriod);
+        }
+        return idle;
+    }
+
+    /**
+     * @brief Do a full system check
+     * @return True if everything ok
+     */
+    [[nodiscard]] bool check() override { return initialized(); }
+
+    /**
+     * @brief Check if a type is in the node list
+     * @tparam T The node's type
+     * @return True if in the list
+     */
+    template<class T>
+    static constexpr bool contains() { return (std::is_same_v<T, Nodes> || ...); }
+
+    /**
+     * @brief Get the id of a node
+     * @tparam T The node's type
+     * @return The id the node gets at init
+     */
+    template<class T>
+    static constexpr driver::NodeId idOf() {
+        static_assert(contains<T>(), "node not in the system");
+        return static_cast<driver::NodeId>(indexOf<T, Nodes...>() + 1);
+    }
+
+    /**
+     * @brief Get a node
+     * @tparam T Node type
+     * @return The node
+     */
+    template<class T>
+    T& getNode() { return std::get<T>(nodes); }
+
+    /**
+     * @brief Add a link between two nodes
+     * @tparam T The node where to create link
+     * @tparam L The other node to link with
+     * @return True if link successfully created
+     */
+    template<class T, class L>
+    bool linkNodes() { return getNode<T>().linkNode(unowned<driver::Node>(getNode<L>())); }
+
+    /**
+     * @brief Get the messenger
+     * @return The messenger
+     */
+    driver::Messenger& getMessenger() { return messenger; }
+
+    /**
+     * @brief Get the node manager
+     * @return The manager
+     */
+    driver::Manager& getManager() { return manager; }
+
+    /**
+     * @brief Get the arena of the frame temporaries
+     * @return The arena
+     */
+    [[nodiscard]] const data::Arena& frameArena() const { return arena; }
+
+private:
+    /// Number of nodes
+    static constexpr size_t nodeCount = sizeof...(Nodes);
+    /// Function running a node
+    using Runner = void (*)(StaticSystem&);
+
+    /**
+     * @brief Run a node through its concrete type
+     * @tparam T The node's type
+     * @param system The system
+     */
+    template<class T>
+    static void runNode(StaticSystem& system) { std::get<T>(system.nodes).T::update(); }
+
+    /// The runners, in the list's order
+    static constexpr std::array<Runner, nodeCount> runners{&StaticSystem::runNode<Nodes>...};
+
+    /**
+     * @brief Run the nodes with a pending wakeup event, earliest deadline first
+     *
+     * Same policy as Manager::update(): a node is postponed to the next frame when
+     * its budget does not fit in what remains of the frame budget.
+     * @param date The frame's date
+     */
+    void runNodes(uint64_t date) {
+        std::array<uint8_t, nodeCount> ready{};
+        size_t count = 0;
+        for (size_t idx = 0; idx < nodeCount; ++idx) {
+            if (bases[idx]->initialized() && bases[idx]->hasWork(date))
+                ready[count++] = static_cast<uint8_t>(idx);
+        }
+        // earliest deadline first, the id (position in the list) breaks the ties
+        std::sort(ready.begin(), ready.begin() + count, [this](uint8_t left, uint8_t right) {
+            if (bases[left]->nodeSchedule.deadline != bases[right]->nodeSchedule.deadline)
+                return bases[left]->nodeSchedule.deadline < bases[right]->nodeSchedule.deadline;
+            return left < right;
+        });
+        uint64_t frameStart = micros64();
+        uint64_t start      = frameStart;
+        bool first          = true;
+        for (size_t idx = 0; idx < count; ++idx) {
+            driver::Node* node        = bases[ready[idx]];
+            driver::Schedule& schedule = node->nodeSchedule;
+            if (!first && start - frameStart + schedule.budget > manager.frameBudget()) {
+                ++schedule.deferred;
+                continue;
+            }
+            first = false;
+            date  = timer::now();
+            {
+                memory::Scope scope{node->id()};
+                runners[ready[idx]](*this);
+            }
+            uint64_t end = micros64();
+            schedule.account(date, end - start);
+            start = end;
+        }
+    }
+
+    /**
+     * @brief Get a pointer that does not own its object (no control block, no counting)
+     * @tparam T The pointer's type
+     * @param object The object, living as long as the system
+     * @return The pointer
+     */
+    template<class T, class U>
+    static std::shared_ptr<T> unowned(U& object) { return std::shared_ptr<T>(std::shared_ptr<T>{}, &object); }
+
+    /**
+     * @brief Get a pointer that does not own its object (no control block, no counting)
+     * @tparam T The object's type
+     * @param object The object, living as long as the system
+     * @return The pointer
+     */
+    template<class T>
+    static std::shared_ptr<T> unowned(T& object) { return unowned<T, T>(object); }
+
+    /**
+     * @brief Get the position of a type in a list
+     * @tparam T The type to find
+     * @tparam First The list's first type
+     * @tparam Rest The other types of the list
+     * @return The position
+     */
+    template<class T, class First, class... Rest>
+    static constexpr size_t indexOf() {
+        if constexpr (std::is_same_v<T, First>)
+            return 0;
+        else
+            return 1 + indexOf<T, Rest...>();
+    }
+
+    // Construction order: the messenger only keeps the manager's address and the
+    // nodes the messenger's. The manager is destroyed first, while its nodes live.
+    /// The message manager
+    driver::Messenger messenger;
+    /// The nodes
+    std::tuple<Nodes...> nodes;
+    /// The nodes as their base class, in the list's order
+    std::array<driver::Node*, nodeCount> bases;
+    /// The driver manager
+    driver::Manager manager;
+    /// The frame temporaries
+    data::Arena arena;
+};
+
+}// namespace obd::core
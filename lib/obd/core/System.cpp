@@ -12,6 +12,7 @@
 //#include "time/Clock.h"
 #include "com/Shell.h"
 #include "com/Stdout.h"
+#include "core/timer/VirtualClock.h"
 
 namespace obd::core {
 
@@ -28,13 +29,12 @@ void System::init() {
     addNode<com::Shell>();
 
     addNode<com::Stdout>();
-    manager->getDriver<com::Shell>()->addOutput(code<com::Stdout>());
+    manager->getDriver<com::Shell>()->addOutput(manager->idOf(code<com::Stdout>()));
 
 
     //    addNode<fs::FileSystem>();
     //    addNode<time::Clock>();
-    //    linkNodes(code<obd::time::Clock>(), code<obd::fs::FileSystem>());
-    //    linkNodes(code<obd::fs::FileSystem>(), code<obd::time::Clock>());
+    // the clock depends on the file system: the manager links them
 
     manager->init();
 }
@@ -43,8 +43,13 @@ void System::update() {
     if (!initialized()) {
         return;
     }
+    data::ArenaScope frame{arena};
     messenger->update();
     manager->update();
+    if (messenger->size() > 0)
+        return;
+    // no node ready: give the time to the network stack (delay yields on ESP)
+    timer::idle(manager->idleTime());
 }
 
 bool System::check() {
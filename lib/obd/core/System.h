@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "data/Arena.h"
 #include "driver/Manager.h"
 #include "driver/Messenger.h"
 
@@ -37,7 +38,9 @@ public:
     void init()override;
 
     /**
-     * @brief Actualization frame
+     * @brief Actualization frame, sleep until the next event when no node is ready
+     *
+     * The frame arena is the current one during the frame, and reset at its end.
      */
     void update()override;
 
@@ -85,11 +88,19 @@ public:
      * @return The messenger
      */
     std::shared_ptr<driver::Messenger> getMessenger(){return messenger;}
+
+    /**
+     * @brief Get the arena of the frame temporaries
+     * @return The arena
+     */
+    [[nodiscard]] const data::Arena& frameArena() const { return arena; }
 private:
     /// The driver manager
     std::shared_ptr<driver::Manager> manager=nullptr;
     /// The message manager
     std::shared_ptr<driver::Messenger> messenger= nullptr;
+    /// The frame temporaries
+    data::Arena arena;
 };
 
 }// namespace obd::core
@@ -0,0 +1,64 @@
+/**
+ * @file Command.cpp
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "Command.h"
+
+namespace obd::core::driver {
+
+namespace {
+
+/**
+ * @brief Text form of a command
+ */
+struct Keyword {
+    /// The command's id
+    CommandId id;
+    /// The command's keyword
+    const char* name;
+};
+
+/// Common and shell commands, the nodes' own commands are in their command tables
+constexpr Keyword keywords[] = {
+        {CommandId::Info, "info"},
+        {CommandId::Help, "help"},
+        {CommandId::Dmesg, "dmesg"},
+        {CommandId::Lsdrv, "lsdrv"},
+        {CommandId::Dlq, "dlq"},
+        {CommandId::Top, "top"},
+        {CommandId::Mem, "mem"},
+};
+
+}// namespace
+
+uint8_t ArgumentList::find(std::string_view word) const {
+    for (uint8_t idx = 0; idx < count; ++idx) {
+        if (word == words[idx])
+            return idx;
+    }
+    return Command::unknownArgument;
+}
+
+Command Command::parse(const Tokenizer::Range& words) {
+    Command result;
+    if (words.empty())
+        return result;
+    const Keyword* keyword = nullptr;
+    for (const auto& item : keywords) {
+        if (words[0] == item.name) {
+            keyword = &item;
+            break;
+        }
+    }
+    // a node's own keyword: the node resolves it
+    result.id = keyword == nullptr ? CommandId::Unknown : keyword->id;
+    if (words.size() > 1)
+        result.argument = unknownArgument;
+    return result;
+}
+
+}// namespace obd::core::driver
@@ -0,0 +1,138 @@
+/**
+ * @file Command.h
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "Tokenizer.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace obd::core::driver {
+
+/**
+ * @brief Identifier of the commands common to all the nodes, and of the shell's ones
+ *
+ * The other commands belong to a node: it declares their ids with nodeCommand()
+ * and their keywords in its command table.
+ */
+enum struct CommandId : uint8_t {
+    None,   ///< Not a command
+    Unknown,///< Text command without common keyword
+    Info,   ///< Node information
+    Help,   ///< Node's command list
+    Dmesg,  ///< System messages
+    Lsdrv,  ///< Driver list
+    Dlq,    ///< Undelivered messages
+    Top,    ///< Execution times of the nodes
+    Mem,    ///< Memory usage of the nodes
+    Node,   ///< First id of the nodes' own commands
+};
+
+/**
+ * @brief Get the id of a command owned by a node
+ * @param index Rank of the command among the node's own ones
+ * @return The command's id (unique in the node only)
+ */
+constexpr CommandId nodeCommand(uint8_t index) {
+    return static_cast<CommandId>(static_cast<uint8_t>(CommandId::Node) + index);
+}
+
+/**
+ * @brief Non-owning view on the argument keywords of a command
+ *
+ * The value of an argument is its index in the list: the nodes declare the
+ * list next to the enum it maps to, in their command table.
+ */
+class ArgumentList {
+public:
+    /**
+     * @brief Command without argument keywords
+     */
+    constexpr ArgumentList() = default;
+
+    /**
+     * @brief Constructor
+     * @tparam N The number of keywords
+     * @param list The keywords, in the order of their values
+     */
+    template<size_t N>
+    constexpr ArgumentList(const char* const (&list)[N]) :// NOLINT(google-explicit-constructor)
+        words{list}, count{static_cast<uint8_t>(N)} {
+        static_assert(N < 0xFE, "too many argument keywords");
+    }
+
+    /**
+     * @brief Get the number of keywords
+     * @return The number of keywords
+     */
+    [[nodiscard]] constexpr uint8_t size() const { return count; }
+
+    /**
+     * @brief Check if the command has argument keywords
+     * @return True if no keyword
+     */
+    [[nodiscard]] constexpr bool empty() const { return count == 0; }
+
+    /**
+     * @brief Get the value of a keyword
+     * @param word The keyword
+     * @return The keyword's index, Command::unknownArgument if not in the list
+     */
+    [[nodiscard]] uint8_t find(std::string_view word) const;
+
+private:
+    /// The keywords
+    const char* const* words = nullptr;
+    /// The number of keywords
+    uint8_t count = 0;
+};
+
+/**
+ * @brief Typed form of a command: keyword and first argument as small integers
+ *
+ * A text command is parsed once, when the message is created: the common
+ * keywords get their id, the others are Unknown until the receiving node
+ * finds them in its command table. Nodes then dispatch on the ids without
+ * any string comparison. The argument is the index of the first parameter
+ * in the argument keywords of the node's command entry, it is resolved when
+ * the node treats the command.
+ * Parameters that are not keywords (file names, servers...) are kept in the
+ * message text.
+ */
+struct Command {
+    /// Argument value when the command has no parameter
+    static constexpr uint8_t noArgument = 0xFF;
+    /// Argument value when the parameter is not in the command's keyword list
+    static constexpr uint8_t unknownArgument = 0xFE;
+
+    /// The command's keyword
+    CommandId id = CommandId::None;
+    /// The command's first argument
+    uint8_t argument = noArgument;
+
+    /**
+     * @brief Check if the command has a parameter
+     * @return True if parameter
+     */
+    [[nodiscard]] constexpr bool hasArgument() const { return argument != noArgument; }
+
+    /**
+     * @brief Check if the first parameter is a known keyword
+     * @return True if valid keyword
+     */
+    [[nodiscard]] constexpr bool validArgument() const { return argument < unknownArgument; }
+
+    /**
+     * @brief Parse a text command
+     * @param words The words of the command
+     * @return The typed command, with unknownArgument if it has a parameter
+     */
+    static Command parse(const Tokenizer::Range& words);
+};
+
+}// namespace obd::core::driver
@@ -0,0 +1,155 @@
+/**
+ * @file CommandTable.h
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "Command.h"
+#include <cstddef>
+
+namespace obd::core::driver {
+
+class Node;
+class Message;
+
+/**
+ * @brief Description of a command accepted by a node
+ */
+struct CommandEntry {
+    /// Function executing the command on a node
+    using Handler = void (*)(Node&, const Message&);
+    /// The command's id
+    CommandId id;
+    /// The command's keyword
+    const char* keyword;
+    /// Minimum number of parameters
+    uint8_t arity;
+    /// The function to call
+    Handler handler;
+    /// Parameters and description, for the help
+    const char* help;
+    /// Keywords of the first parameter, resolved into the command's argument
+    ArgumentList arguments;
+};
+
+/**
+ * @brief Get the node's type of a command member function
+ * @tparam F The member function type
+ */
+template<class F>
+struct CommandOwner;
+
+/**
+ * @brief Get the node's type of a command member function
+ * @tparam T The node's type
+ */
+template<class T>
+struct CommandOwner<void (T::*)(const Message&)> {
+    /// The node's type
+    using type = T;
+};
+
+/**
+ * @brief Call a command member function on a node
+ * @tparam function The member function
+ * @param node The node (must be of the function's class)
+ * @param message The command
+ */
+template<auto function>
+void invokeCommand(Node& node, const Message& message) {
+    using T = typename CommandOwner<decltype(function)>::type;
+    (static_cast<T&>(node).*function)(message);
+}
+
+/**
+ * @brief Convert a member function of a node into a command handler
+ * @tparam function The member function
+ * @return The handler
+ */
+template<auto function>
+constexpr CommandEntry::Handler commandHandler() {
+    return &invokeCommand<function>;
+}
+
+/**
+ * @brief Non-owning view on a constant array of commands, sorted by id
+ */
+class CommandTable {
+public:
+    /**
+     * @brief Empty table
+     */
+    constexpr CommandTable() = default;
+
+    /**
+     * @brief Constructor
+     * @tparam N The number of commands
+     * @param table The commands, sorted by id
+     */
+    template<size_t N>
+    constexpr CommandTable(const CommandEntry (&table)[N]) :// NOLINT(google-explicit-constructor)
+        entries{table}, count{N} {}
+
+    /**
+     * @brief Check if a table is sorted by id, as needed by find
+     * @tparam N The number of commands
+     * @param table The commands
+     * @return True if sorted without duplicates
+     */
+    template<size_t N>
+    static constexpr bool sorted(const CommandEntry (&table)[N]) {
+        for (size_t idx = 1; idx < N; ++idx)
+            if (!(table[idx - 1].id < table[idx].id))
+                return false;
+        return true;
+    }
+
+    /**
+     * @brief Search a command (binary search)
+     * @param id The command's id
+     * @return The command or nullptr
+     */
+    [[nodiscard]] constexpr const CommandEntry* find(CommandId id) const {
+        size_t low  = 0;
+        size_t high = count;
+        while (low < high) {
+            size_t mid = (low + high) / 2;
+            if (entries[mid].id == id)
+                return entries + mid;
+            if (entries[mid].id < id)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Iterator on the first command
+     * @return Iterator
+     */
+    [[nodiscard]] constexpr const CommandEntry* begin() const { return entries; }
+
+    /**
+     * @brief Iterator after the last command
+     * @return Iterator
+     */
+    [[nodiscard]] constexpr const CommandEntry* end() const { return entries + count; }
+
+    /**
+     * @brief Get the number of commands
+     * @return The number of commands
+     */
+    [[nodiscard]] constexpr size_t size() const { return count; }
+
+private:
+    /// The commands
+    const CommandEntry* entries = nullptr;
+    /// The number of commands
+    size_t count = 0;
+};
+
+}// namespace obd::core::driver
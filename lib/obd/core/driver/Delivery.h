@@ -0,0 +1,76 @@
+/**
+ * @file Delivery.h
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include <cstdint>
+
+namespace obd::core::driver {
+
+/**
+ * @brief Outcome of a message delivery to a node
+ *
+ * Converts to true only when the message has been accepted, so that it can be
+ * tested as the former boolean result.
+ */
+class Delivery {
+public:
+    /**
+     * @brief Delivery status
+     */
+    enum struct Status : uint8_t {
+        Accepted,   ///< Message queued or handled
+        Saturated,  ///< Queue of the target full: may succeed later
+        Refused,    ///< Message not wanted by the target (unknown command, bad destination...)
+        Unreachable,///< No target for the message
+    };
+
+    /**
+     * @brief Constructor
+     * @param stat The status
+     */
+    constexpr Delivery(Status stat = Status::Accepted) :// NOLINT(google-explicit-constructor)
+        deliveryStatus{stat} {}
+
+    /**
+     * @brief Check for acceptance
+     * @return True if accepted
+     */
+    constexpr explicit operator bool() const { return deliveryStatus == Status::Accepted; }
+
+    /**
+     * @brief Check if the target is saturated (worth retrying)
+     * @return True if saturated
+     */
+    [[nodiscard]] constexpr bool saturated() const { return deliveryStatus == Status::Saturated; }
+
+    /**
+     * @brief Get the status
+     * @return The status
+     */
+    [[nodiscard]] constexpr const Status& status() const { return deliveryStatus; }
+
+    /**
+     * @brief Compare with a status
+     * @param stat The status
+     * @return True if identical
+     */
+    constexpr bool operator==(const Status& stat) const { return deliveryStatus == stat; }
+
+    /**
+     * @brief Compare with a status
+     * @param stat The status
+     * @return True if different
+     */
+    constexpr bool operator!=(const Status& stat) const { return deliveryStatus != stat; }
+
+private:
+    /// The status
+    Status deliveryStatus;
+};
+
+}// namespace obd::core::driver
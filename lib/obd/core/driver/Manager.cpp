@@ -7,44 +7,283 @@
  */
 
 #include "Manager.h"
+#include "core/memory/MemoryTracker.h"
+#include "core/timer/VirtualClock.h"
+#include "native/fakeArduino.h"
 
 namespace obd::core::driver {
 
+Manager::~Manager() {
+    // the timers die with the manager, not necessarily the nodes
+    for (const auto& node : nodes)
+        node->timerService = nullptr;
+}
+
 Manager::NodeType Manager::getNode(const Manager::NameType& nodeName)  {
-    auto search = find_if(begin(),end(),[nodeName](const NodeType& driver) { return nodeName == driver->name(); });
-    if (search == end())
-        return nullptr;
-    return *search;
+    return getNodeById(idOf(nodeName));
 }
 
 Manager::NodeType Manager::getNode(const size_t& nodeHash) {
-    auto search = find_if(begin(),end(),[nodeHash](const NodeType& driver) { return nodeHash == driver->type(); });
-    if (search == end())
+    return getNodeById(idOf(nodeHash));
+}
+
+Manager::NodeType Manager::getNodeById(const NodeId& nodeId) {
+    if (nodeId == broadcastId || nodeId > nodes.size())
         return nullptr;
-    return *search;
+    return nodes[nodeId - 1];
+}
+
+NodeId Manager::idOf(const Manager::NameType& nodeName) const {
+    auto search = nameIndex.find(nodeName);
+    if (search == nameIndex.end())
+        return unknownId;
+    return search->second;
+}
+
+NodeId Manager::idOf(const size_t& nodeHash) const {
+    auto search = hashIndex.find(nodeHash);
+    if (search == hashIndex.end())
+        return unknownId;
+    return search->second;
+}
+
+Manager::NameType Manager::nameOf(const NodeId& nodeId) const {
+    if (nodeId == broadcastId || nodeId > names.size())
+        return "Unknown";
+    return names[nodeId - 1];
+}
+
+Manager::BaseNodeType* Manager::route(const NodeId& nodeId) const {
+    if (nodeId == broadcastId || nodeId > nodes.size())
+        return nullptr;
+    return nodes[nodeId - 1].get();
+}
+
+const Manager::RouteList& Manager::categoryList(const Category& cat) const {
+    return categoryRoutes[static_cast<size_t>(cat)];
+}
+
+bool Manager::addNode(const NodeType& node) {
+    if (node == nullptr || nodes.size() >= maxNodes)
+        return false;
+    if (hashIndex.find(node->type()) != hashIndex.end())
+        return false;
+    nodes.push_back(node);
+    readyList.reserve(nodes.size());
+    node->nodeId       = static_cast<NodeId>(nodes.size());
+    node->timerService = &timers;
+    buildRoutes();
+    return true;
+}
+
+void Manager::buildRoutes() {
+    names.clear();
+    hashIndex.clear();
+    nameIndex.clear();
+    broadcastRoutes.clear();
+    for (auto& list : categoryRoutes)
+        list.clear();
+    for (const auto& node : nodes) {
+        names.push_back(node->name());
+        hashIndex.emplace(node->type(), node->id());
+        nameIndex.emplace(names.back(), node->id());
+        broadcastRoutes.push_back(node.get());
+        categoryRoutes[static_cast<size_t>(node->category())].push_back(node.get());
+    }
+}
+void Manager::sortNodes() {
+    bootOrder.clear();
+    // wave of each node, nodes.size() while not placed
+    std::vector<size_t> waves(nodes.size(), nodes.size());
+    for (const auto& node : nodes) {
+        node->nodeInitState = InitState::Waiting;
+        for (const auto& dependency : node->dependencies()) {
+            if (idOf(dependency) == unknownId)
+                node->nodeInitState = InitState::MissingDependency;
+        }
+    }
+    for (size_t wave = 0; bootOrder.size() < nodes.size(); ++wave) {
+        size_t waveStart = bootOrder.size();
+        auto placed = [&](size_t dependency) {
+            NodeId depId = idOf(dependency);
+            return depId == unknownId || waves[depId - 1] < wave;
+        };
+        // a node joins the wave when its dependencies are in the previous waves,
+        // the optional ones are ignored only when they would make a cycle
+        for (bool optional : {true, false}) {
+            for (const auto& node : nodes) {
+                if (waves[node->id() - 1] != nodes.size())
+                    continue;
+                const auto& dependencies = node->dependencies();
+                const auto& optionals    = node->optionalDependencies();
+                if (std::all_of(dependencies.begin(), dependencies.end(), placed) &&
+                    (!optional || std::all_of(optionals.begin(), optionals.end(), placed)))
+                    bootOrder.push_back(node.get());
+            }
+            if (bootOrder.size() != waveStart)
+                break;
+        }
+        if (bootOrder.size() == waveStart)
+            break;
+        for (auto idx = waveStart; idx < bootOrder.size(); ++idx)
+            waves[bootOrder[idx]->id() - 1] = wave;
+    }
+    // the remaining nodes wait for themselves
+    for (const auto& node : nodes) {
+        if (waves[node->id() - 1] == nodes.size())
+            node->nodeInitState = InitState::Cycle;
+    }
 }
 
-bool Manager::addNode(const NodeType& node) {;
-    auto search = find_if(begin(),end(),[node](const NodeType& driver) { return node->type() == driver->type(); });
-    if (search == end()) {
-        nodes.push_back(node);
-        return true;
+bool Manager::resolveDependencies(BaseNodeType* node) {
+    for (const auto& dependency : node->dependencies()) {
+        auto other = getNode(dependency);
+        if (other->nodeInitState == InitState::Waiting || other->nodeInitState == InitState::Pending)
+            return false;
+        if (other->nodeInitState != InitState::Done) {
+            node->nodeInitState = InitState::MissingDependency;
+            node->console("missing or failed dependency, not initialized", Message::MessageType::Error);
+            return false;
+        }
+    }
+    for (const auto& dependency : node->dependencies())
+        linkNodes(node, getNode(dependency).get());
+    // the optional dependencies not yet initialized are linked when they are
+    for (const auto& dependency : node->optionalDependencies()) {
+        auto other = getNode(dependency);
+        if (other != nullptr && other->nodeInitState == InitState::Done)
+            linkNodes(node, other.get());
     }
-    return false;
+    return true;
 }
+
+void Manager::linkOptionals(BaseNodeType* node) {
+    for (const auto& other : nodes) {
+        if (other->nodeInitState != InitState::Pending && other->nodeInitState != InitState::Done)
+            continue;
+        // already linked as a dependency of the node
+        const auto& dependencies = node->dependencies();
+        if (std::find(dependencies.begin(), dependencies.end(), other->type()) != dependencies.end())
+            continue;
+        const auto& optionals = other->optionalDependencies();
+        if (std::find(optionals.begin(), optionals.end(), node->type()) != optionals.end())
+            linkNodes(other.get(), node);
+    }
+}
+
+void Manager::linkNodes(BaseNodeType* node, BaseNodeType* other) {
+    node->linkNode(getNodeById(other->id()));
+    other->linkNode(getNodeById(node->id()));
+}
+
+void Manager::stepInit() {
+    uint64_t date = timer::now();
+    bootPending   = false;
+    // the dependencies come first: a node can start in the pass its dependencies end
+    for (auto* node : bootOrder) {
+        if (node->nodeInitState == InitState::Waiting) {
+            if (!resolveDependencies(node)) {
+                bootPending = bootPending || node->nodeInitState == InitState::Waiting;
+                continue;
+            }
+            node->nodeInitState = InitState::Pending;
+        } else if (node->nodeInitState != InitState::Pending) {
+            continue;
+        } else if (node->initRetry > date) {
+            bootPending = true;
+            continue;
+        }
+        InitStatus status;
+        {
+            memory::Scope scope{node->id()};
+            status = node->initStep();
+        }
+        if (status == InitStatus::Pending) {
+            bootPending = true;
+            continue;
+        }
+        node->nodeInitState = status == InitStatus::Done && node->initialized() ? InitState::Done : InitState::Failed;
+        if (node->nodeInitState == InitState::Done)
+            linkOptionals(node);
+    }
+}
+
 void Manager::init() {
     Object::init();
-    for(const auto& node:nodes){
-        node->init();
+    sortNodes();
+    for (const auto& node : nodes) {
+        if (node->nodeInitState == InitState::MissingDependency)
+            node->console("missing or failed dependency, not initialized", Message::MessageType::Error);
+        else if (node->nodeInitState == InitState::Cycle)
+            node->console("dependency cycle, not initialized", Message::MessageType::Error);
     }
+    stepInit();
 }
+
 void Manager::update() {
     if (!initialized()) {
         return;
     }
-    for(const auto& node:nodes){
-        node->update();
+    uint64_t date = startFrame();
+    readyList.clear();
+    for (const auto& node : nodes) {
+        if (node->initialized() && node->hasWork(date))
+            readyList.push_back(node.get());
+    }
+    // earliest deadline first, the id breaks the ties
+    std::sort(readyList.begin(), readyList.end(), [](const BaseNodeType* left, const BaseNodeType* right) {
+        if (left->nodeSchedule.deadline != right->nodeSchedule.deadline)
+            return left->nodeSchedule.deadline < right->nodeSchedule.deadline;
+        return left->id() < right->id();
+    });
+    uint64_t frameStart = micros64();
+    uint64_t start      = frameStart;
+    bool first          = true;
+    for (auto* node : readyList) {
+        Schedule& schedule = node->nodeSchedule;
+        if (!first && start - frameStart + schedule.budget > maxFrameTime) {
+            ++schedule.deferred;
+            continue;
+        }
+        first = false;
+        date = timer::now();
+        {
+            memory::Scope scope{node->id()};
+            node->update();
+        }
+        uint64_t end = micros64();
+        schedule.account(date, end - start);
+        start = end;
+    }
+}
+
+uint64_t Manager::startFrame() {
+    if (bootPending)
+        stepInit();
+    uint64_t date = timer::now();
+    timers.advance(date);
+    return date;
+}
+
+uint64_t Manager::idleTime() {
+    uint64_t now = timer::now();
+    // the expired timers wake their nodes up
+    timers.advance(now);
+    uint64_t idle = std::min(config::maxIdleTime, timers.idleTime());
+    for (const auto& node : nodes) {
+        if (node->nodeInitState == InitState::Pending)
+            idle = std::min(idle, node->initRetry > now ? node->initRetry - now : 0);
+        if (!node->initialized())
+            continue;
+        if (node->hasWork(now))
+            return 0;
+        const Schedule& schedule = node->nodeSchedule;
+        if (hasWakeup(schedule.wakeups, Wakeup::Timer))
+            idle = std::min(idle, schedule.deadline - now);
+        if (hasWakeup(schedule.wakeups, Wakeup::Io))
+            idle = std::min(idle, config::ioPollPeriod);
     }
+    return idle;
 }
 
 }// namespace obd::core::driver
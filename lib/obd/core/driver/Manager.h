@@ -9,7 +9,10 @@
 #pragma once
 #include "Node.h"
 #include <algorithm>
+#include <array>
+#include <map>
 #include <memory>
+#include <unordered_map>
 
 namespace obd::core::driver {
 
@@ -29,17 +32,50 @@ public:/// Pointer to a driver node
     using iterator = NodeList::iterator;
     /// Constant iterator type
     using const_iterator = NodeList::const_iterator;
+    /// List of raw node pointers used for routing
+    using RouteList = std::vector<BaseNodeType*>;
 
     /**
      * @brief Default constructor.
      */
     Manager() = default;
+    Manager(const Manager&) = delete;
+    Manager(Manager&&)      = delete;
+    Manager& operator=(const Manager&) = delete;
+    Manager& operator=(Manager&&) = delete;
 
     /**
-     * @brief initialize
+     * @brief Destructor, detach the nodes from the timers
+     */
+    ~Manager() override;
+
+    /**
+     * @brief Start the initialization of the nodes, each one after its dependencies
+     *
+     * The nodes are sorted by waves: a wave holds the nodes whose dependencies are
+     * all in the previous waves, in insertion order. Each dependency is linked both
+     * ways with its dependent before the init. The nodes with a missing or failed
+     * dependency, or in a cycle, are not initialized and report it on the console.
+     * An optional dependency only orders the init when it makes no cycle, and is
+     * linked once both nodes are initialized.
+     *
+     * The nodes' init steps are interleaved: the pending ones are stepped again by
+     * the next frames, while the initialized nodes already run.
      */
     void init()override;
 
+    /**
+     * @brief Check if some nodes are still initializing
+     * @return True if an initialization is pending
+     */
+    [[nodiscard]] bool booting() const { return bootPending; }
+
+    /**
+     * @brief Get the nodes in initialization order (the nodes in a cycle are excluded)
+     * @return The initialization order
+     */
+    [[nodiscard]] const RouteList& initOrder() const { return bootOrder; }
+
     /**
      * @brief Get a pointer to the node given its name
      * @param nodeName The name of the node
@@ -54,6 +90,34 @@ public:/// Pointer to a driver node
      */
     [[nodiscard]] NodeType getNode(const size_t& nodeHash);
 
+    /**
+     * @brief Get a pointer to the node given its id
+     * @param nodeId The id of the node
+     * @return The node.
+     */
+    [[nodiscard]] NodeType getNodeById(const NodeId& nodeId);
+
+    /**
+     * @brief Get the id of a node given its name
+     * @param nodeName The name of the node
+     * @return The node's id, unknownId if not found
+     */
+    [[nodiscard]] NodeId idOf(const NameType& nodeName) const;
+
+    /**
+     * @brief Get the id of a node given its type hash
+     * @param nodeHash The type hash of the node
+     * @return The node's id, unknownId if not found
+     */
+    [[nodiscard]] NodeId idOf(const size_t& nodeHash) const;
+
+    /**
+     * @brief Get the name of a node given its id
+     * @param nodeId The id of the node
+     * @return The node's name, "Unknown" if not found
+     */
+    [[nodiscard]] NameType nameOf(const NodeId& nodeId) const;
+
     /**
      * @brief Get the driver of the given type
      * @tparam T The driver's type to search
@@ -63,16 +127,29 @@ public:/// Pointer to a driver node
     std::shared_ptr<T> getDriver() {
         if (!std::is_base_of<BaseNodeType, T>::value)// only class derived from Node is allowed
             return nullptr;
-        auto search = std::find_if(begin(), end(),
-                                   [](const NodeType& driver) {
-                                       return typeid(T).hash_code() == driver->type();
-                                   });
-        if (search == end()) {
-            return nullptr;
-        }
-        return std::dynamic_pointer_cast<T>(*search);
+        return std::dynamic_pointer_cast<T>(getNode(typeid(T).hash_code()));
     }
 
+    /**
+     * @brief Get the node that should receive the messages for the given id
+     * @param nodeId The destination id
+     * @return The node or nullptr if none
+     */
+    [[nodiscard]] BaseNodeType* route(const NodeId& nodeId) const;
+
+    /**
+     * @brief Get the list of nodes that receive broadcast messages
+     * @return The broadcast list
+     */
+    [[nodiscard]] const RouteList& broadcastList() const { return broadcastRoutes; }
+
+    /**
+     * @brief Get the list of nodes of the given category
+     * @param cat The category
+     * @return The nodes in this category
+     */
+    [[nodiscard]] const RouteList& categoryList(const Category& cat) const;
+
     /**
      * @brief Get begin iterator of the driver list
      * @return Begin iterator of the driver list
@@ -115,17 +192,110 @@ public:/// Pointer to a driver node
     [[nodiscard]] size_t size() const { return nodes.size(); }
 
     /**
-     * @brief Add the given node to the list
+     * @brief Add the given node to the list, and give it its id
      * @param node The node to add
      * @return True if the node truly added
      */
     bool addNode(const NodeType& node);
 
+    /**
+     * @brief Run the nodes with a pending wakeup event (message, deadline, I/O), earliest deadline first
+     *
+     * A node is postponed to the next frame when its budget does not fit in what remains
+     * of the frame budget (the first node of the frame always runs).
+     */
     void update()override;
 
+    /**
+     * @brief Start a frame: step the pending initializations and fire the expired timers
+     * @return The frame's date in microseconds
+     */
+    uint64_t startFrame();
+
+    /**
+     * @brief Get the time allowed to the nodes in one frame
+     * @return The frame budget in microseconds
+     */
+    [[nodiscard]] uint64_t frameBudget() const { return maxFrameTime; }
+
+    /**
+     * @brief Define the time allowed to the nodes in one frame
+     * @param budget The frame budget in microseconds
+     */
+    void setFrameBudget(uint64_t budget) { maxFrameTime = budget; }
+
+    /**
+     * @brief Get the timers shared by the nodes
+     * @return The timer service
+     */
+    timer::TimerService& timerService() { return timers; }
+
+    /**
+     * @brief Get the time during which no node will be ready, if nothing else happens
+     * @return The idle time in microseconds (0 if a node is ready)
+     */
+    [[nodiscard]] uint64_t idleTime();
+
 private:
-    /// Node’s list
+    /// Maximum number of nodes (ids 0 and 0xFF are reserved)
+    static constexpr size_t maxNodes = unknownId - 1;
+    /// Node’s list, the node of id N is in the slot N-1
     NodeList nodes;
+    /// Node's names, same indexing as the node's list
+    std::vector<NameType> names;
+    /// Type index: type hash to node id
+    std::unordered_map<size_t, NodeId> hashIndex;
+    /// Name index: node name to node id
+    std::map<NameType, NodeId> nameIndex;
+    /// Nodes receiving the broadcast messages
+    RouteList broadcastRoutes;
+    /// Nodes per category
+    std::array<RouteList, static_cast<size_t>(Category::Communicator) + 1> categoryRoutes;
+    /// Nodes to run in the current frame (kept to avoid allocations)
+    RouteList readyList;
+    /// Nodes in initialization order
+    RouteList bootOrder;
+    /// If some nodes are still initializing
+    bool bootPending = false;
+    /// Time allowed to the nodes in one frame
+    uint64_t maxFrameTime = config::frameBudget;
+    /// Timers of the nodes, advanced each frame
+    timer::TimerService timers;
+
+    /**
+     * @brief Rebuild all the routing index from the node list
+     */
+    void buildRoutes();
+
+    /**
+     * @brief Sort the nodes by dependency waves, mark the missing dependencies and the cycles
+     */
+    void sortNodes();
+
+    /**
+     * @brief Check if the dependencies of a node are initialized, and link them
+     * @param node The node
+     * @return True if the node can be initialized
+     */
+    bool resolveDependencies(BaseNodeType* node);
+
+    /**
+     * @brief Link a node just initialized to the started nodes using it as optional dependency
+     * @param node The node
+     */
+    void linkOptionals(BaseNodeType* node);
+
+    /**
+     * @brief Link two nodes both ways
+     * @param node The dependent node
+     * @param other Its dependency
+     */
+    void linkNodes(BaseNodeType* node, BaseNodeType* other);
+
+    /**
+     * @brief Do the initialization steps that are due, in initialization order
+     */
+    void stepInit();
 };
 
 }// namespace obd::core::driver
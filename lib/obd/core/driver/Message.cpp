@@ -7,180 +7,219 @@
  */
 
 #include "Message.h"
-#include "data/DataUtils.h"
-#include <bitset>
-#include <iomanip>
-#include <sstream>
+#include <cstdio>
 
 namespace obd::core::driver {
 
-Message::DataType Message::getBaseCommand() const {
-    Message::DataType result = message.substr(0, message.find(' '));
-    return result;
+namespace {
+
+/// Digits used to format integers
+constexpr char digitChars[] = "0123456789abcdef";
+
+/// Maximum length of a formatted integer (64 binary digits + sign)
+constexpr uint8_t maxIntegerLength = 65;
+
+/**
+ * @brief Append an unsigned integer to a payload, without allocation
+ * @param output The payload to complete
+ * @param value The value to format
+ * @param base The numeric base (2, 10 or 16)
+ * @param minDigits Minimum amount of digits (zero padded)
+ * @param negative If a minus sign should be added
+ */
+void appendInteger(Payload& output, uint64_t value, uint8_t base, uint8_t minDigits = 1, bool negative = false) {
+    char buffer[maxIntegerLength];
+    char* end      = buffer + maxIntegerLength;
+    char* begin    = end;
+    uint8_t digits = 0;
+    do {
+        *--begin = digitChars[value % base];
+        value /= base;
+        ++digits;
+    } while (value != 0);
+    while (digits < minDigits && begin > buffer + 1) {
+        *--begin = '0';
+        ++digits;
+    }
+    if (negative)
+        *--begin = '-';
+    output.append(begin, static_cast<Payload::size_type>(end - begin));
+}
+
+/**
+ * @brief Append a signed integer in decimal form
+ * @param output The payload to complete
+ * @param value The value to format
+ */
+void appendDecimal(Payload& output, int64_t value) {
+    // negate in unsigned to support the minimal value
+    uint64_t absValue = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    appendInteger(output, absValue, 10, 1, value < 0);
+}
+
+/**
+ * @brief Append an unsigned integer given its width in bits
+ * @param output The payload to complete
+ * @param value The value to format (already truncated to bits)
+ * @param format The format
+ * @param bits The width of the integer
+ */
+void appendUnsigned(Payload& output, uint64_t value, Format format, uint8_t bits) {
+    switch (format) {
+    case Format::Auto:
+    case Format::Decimal:
+        appendInteger(output, value, 10);
+        break;
+    case Format::Hexadecimal:
+        appendInteger(output, value, 16, bits / 4);
+        break;
+    case Format::Binary:
+        appendInteger(output, value, 2, bits);
+        break;
+    }
+}
+
+}// namespace
+
+OString Message::getBaseCommand() const {
+    return OString{getWords()[0]};
 }
 
 bool Message::hasParams() const {
-    return message.find(' ') != OString::npos;
+    return tokens().size() > 1;
+}
+
+bool Message::isTruncated() const {
+    return tokens().isTruncated();
 }
 
 Message::MultipleData Message::getParams() const {
-    if (message.find(' ') == OString::npos)
+    MultipleData result;
+    for (const auto& word : getWords(1))
+        result.emplace_back(word);
+    return result;
+}
+
+OString Message::getParamStr() const {
+    if (tokens().size() < 2)
         return {};
-    return data::split(getParamStr(), " ");
+    // raw text from the first parameter, quotes included
+    const Tokenizer::Span& first = tokens()[1];
+    Payload::size_type start     = first.quoted ? first.start - 1 : first.start;
+    return message.substr(start);
+}
+
+data::ArenaString Message::getParamStr(data::Arena* arena) const {
+    data::ArenaString result{data::ArenaAllocator<char>{arena}};
+    if (tokens().size() < 2)
+        return result;
+    const Tokenizer::Span& first = tokens()[1];
+    Payload::size_type start     = first.quoted ? first.start - 1 : first.start;
+    result.assign(message.c_str() + start, message.size() - start);
+    return result;
+}
+
+Tokenizer::Range Message::getWords(uint8_t first) const {
+    return tokens().range(message.c_str(), first);
 }
-Message::DataType Message::getParamStr() const {
-    return message.substr(message.find(' ') + 1);
+
+const Tokenizer& Message::tokens() const {
+    if (!tokenized) {
+        tokenizer.parse(message.c_str(), message.size());
+        tokenized = true;
+    }
+    return tokenizer;
+}
+
+Payload& Message::edit() {
+    tokenized     = false;
+    commandParsed = false;
+    return message;
 }
 
 void Message::print(const OString& data) {
-    message += data;
+    edit().append(data.c_str(), static_cast<Payload::size_type>(data.length()));
 }
+
 void Message::print(const char* data) {
-    print(OString(data));
+    edit().append(data);
 }
 
 void Message::print(int8_t data, Format format) {
-    std::stringstream oss;
     switch (format) {
     case Format::Auto:
-        oss << data;
+        // as a char
+        if (data != 0)
+            edit().push_back(static_cast<char>(data));
         break;
     case Format::Decimal:
-        oss << static_cast<int16_t>(data);
+        appendDecimal(edit(), data);
         break;
     case Format::Hexadecimal:
-        oss << std::setfill('0') << std::setw(2) << std::hex << static_cast<int16_t>(data);
+        // sign extended to 16 bits, at least 2 digits
+        appendInteger(edit(), static_cast<uint16_t>(static_cast<int16_t>(data)), 16, 2);
         break;
     case Format::Binary:
-        std::bitset<8> bitset(data);
-        oss << bitset;
+        appendUnsigned(edit(), static_cast<uint8_t>(data), format, 8);
         break;
     }
-    print(oss.str().c_str());
 }
 
 void Message::print(uint8_t data, Format format) {
-    std::stringstream oss;
     switch (format) {
     case Format::Auto:
-        oss << data;
+        // as a char
+        if (data != 0)
+            edit().push_back(static_cast<char>(data));
         break;
     case Format::Decimal:
-        oss << static_cast<uint16_t>(data);
-        break;
     case Format::Hexadecimal:
-        oss << std::setfill('0') << std::setw(2) << std::hex << static_cast<uint16_t>(data);
-        break;
     case Format::Binary:
-        std::bitset<8> bitset(data);
-        oss << bitset;
+        appendUnsigned(edit(), data, format, 8);
         break;
     }
-    print(oss.str().c_str());
 }
 
 void Message::print(int16_t data, Format format) {
-    std::stringstream oss;
-    switch (format) {
-    case Format::Auto:
-    case Format::Decimal:
-        oss << data;
-        break;
-    case Format::Hexadecimal:
-        oss << std::setfill('0') << std::setw(4) << std::hex << data;
-        break;
-    case Format::Binary:
-        std::bitset<16> bitset(data);
-        oss << bitset;
-        break;
-    }
-    print(oss.str().c_str());
+    if (format == Format::Auto || format == Format::Decimal)
+        appendDecimal(edit(), data);
+    else
+        appendUnsigned(edit(), static_cast<uint16_t>(data), format, 16);
 }
+
 void Message::print(uint16_t data, Format format) {
-    std::stringstream oss;
-    switch (format) {
-    case Format::Auto:
-    case Format::Decimal:
-        oss << data;
-        break;
-    case Format::Hexadecimal:
-        oss << std::setfill('0') << std::setw(4) << std::hex << data;
-        break;
-    case Format::Binary:
-        std::bitset<16> bitset(data);
-        oss << bitset;
-        break;
-    }
-    print(oss.str().c_str());
+    appendUnsigned(edit(), data, format, 16);
 }
+
 void Message::print(int32_t data, Format format) {
-    std::stringstream oss;
-    switch (format) {
-    case Format::Auto:
-    case Format::Decimal:
-        oss << data;
-        print(oss.str().c_str());
-        break;
-    case Format::Hexadecimal:
-    case Format::Binary:
-        print(static_cast<int16_t>((data >> 16U) & 0xffff), format);
-        print(static_cast<int16_t>(data & 0xffff), format);
-        break;
-    }
+    if (format == Format::Auto || format == Format::Decimal)
+        appendDecimal(edit(), data);
+    else
+        appendUnsigned(edit(), static_cast<uint32_t>(data), format, 32);
 }
+
 void Message::print(uint32_t data, Format format) {
-    std::stringstream oss;
-    switch (format) {
-    case Format::Auto:
-    case Format::Decimal:
-        oss << data;
-        print(oss.str().c_str());
-        break;
-    case Format::Hexadecimal:
-    case Format::Binary:
-        print(static_cast<uint16_t>((data >> 16U) & 0xffff), format);
-        print(static_cast<uint16_t>(data & 0xffff), format);
-        break;
-    }
+    appendUnsigned(edit(), data, format, 32);
 }
+
 void Message::print(int64_t data, Format format) {
-    std::stringstream oss;
-    switch (format) {
-    case Format::Auto:
-    case Format::Decimal:
-        oss << data;
-        print(oss.str().c_str());
-        break;
-    case Format::Hexadecimal:
-    case Format::Binary:
-        print(static_cast<int16_t>((data >> 48U) & 0xffff), format);
-        print(static_cast<int16_t>((data >> 32U) & 0xffff), format);
-        print(static_cast<int16_t>((data >> 16U) & 0xffff), format);
-        print(static_cast<int16_t>(data & 0xffff), format);
-        break;
-    }
+    if (format == Format::Auto || format == Format::Decimal)
+        appendDecimal(edit(), data);
+    else
+        appendUnsigned(edit(), static_cast<uint64_t>(data), format, 64);
 }
+
 void Message::print(uint64_t data, Format format) {
-    std::stringstream oss;
-    switch (format) {
-    case Format::Auto:
-    case Format::Decimal:
-        oss << data;
-        print(oss.str().c_str());
-        break;
-    case Format::Hexadecimal:
-    case Format::Binary:
-        print(static_cast<uint16_t>((data >> 48U) & 0xffff), format);
-        print(static_cast<uint16_t>((data >> 32U) & 0xffff), format);
-        print(static_cast<uint16_t>((data >> 16U) & 0xffff), format);
-        print(static_cast<uint16_t>(data & 0xffff), format);
-        break;
-    }
+    appendUnsigned(edit(), data, format, 64);
 }
+
 void Message::print(double data, int digit) {
-    std::stringstream oss;
-    oss << std::fixed << std::setprecision(digit) << data;
-    print(oss.str().c_str());
+    int len = snprintf(nullptr, 0, "%.*f", digit, data);
+    if (len <= 0)
+        return;
+    char* dest = edit().grow(static_cast<Payload::size_type>(len));
+    if (dest != nullptr)
+        snprintf(dest, static_cast<size_t>(len) + 1, "%.*f", digit, data);
 }
 
 void Message::println() {
@@ -188,7 +227,8 @@ void Message::println() {
 }
 
 void Message::println(const OString& data) {
-    print(data + "\n");
+    print(data);
+    println();
 }
 
 void Message::println(const char* data) {
@@ -244,13 +284,38 @@ void Message::printlnBool(bool ptr) {
     printBool(ptr);
     println();
 }
+
+void Message::resolveCommand(CommandId id, const ArgumentList& arguments) {
+    const Command& current = getCommand();
+    // typed commands carry their id and value already
+    if (message.empty())
+        return;
+    command.id = id;
+    if (!current.hasArgument() || arguments.empty())
+        return;
+    command.argument = arguments.find(getWords(1)[0]);
+}
+
+void Message::parseCommand() const {
+    tokenized     = false;
+    commandParsed = true;
+    // typed commands have no text: keep them
+    if (message.empty())
+        return;
+    if (messageType == MessageType::Command || messageType == MessageType::Input)
+        command = Command::parse(getWords());
+    else
+        command = Command{};
+}
+
 bool Message::isForAll() const {
-    return destinationId == 0;
+    return destinationId == broadcastId && messageTopic == Topic::None;
 }
 
 
-bool Message::isForMe(const size_t& myId) const {
-    if (isForAll())
+bool Message::isForMe(const NodeId& myId) const {
+    // published messages are only delivered to the subscribers
+    if (isForAll() || isPublished())
         return true;
     if (destinationId == myId)
         return true;
@@ -8,13 +8,28 @@
 
 #pragma once
 
+#include "Command.h"
+#include "Payload.h"
+#include "Tokenizer.h"
+#include "Topic.h"
+#include "data/Arena.h"
 #include "native/OString.h"
+#include <cstdint>
 #include <vector>
 /**
  * @brief Namespace for hardware management
  */
 namespace obd::core::driver {
 
+/// Dense identifier of a node, assigned by the Manager at registration
+using NodeId = uint8_t;
+
+/// Node id meaning 'every node'
+constexpr NodeId broadcastId = 0;
+
+/// Node id of a node not registered in any Manager
+constexpr NodeId unknownId = 0xFF;
+
 
 /**
  * @brief Output format for integers
@@ -32,9 +47,9 @@ enum struct Format {
 class Message {
 public:
     /// Data type
-    using DataType = OString;
+    using DataType = Payload;
     /// List of data
-    using MultipleData = std::vector<DataType>;
+    using MultipleData = std::vector<OString>;
     /// Format of integers
     using Format = obd::core::driver::Format;
 
@@ -49,13 +64,18 @@ public:
     };
 
 
+    /**
+     * @brief Default constructor (empty message from nobody to all)
+     */
+    Message() = default;
+
     /**
      * @brief Constructor with command
      * @param src The source's name of the message
      * @param dest The destination's name of the message
      * @param type The message's type
      */
-    Message(const size_t& src, const size_t& dest, const MessageType& type = MessageType::Message) :
+    Message(const NodeId& src, const NodeId& dest, const MessageType& type = MessageType::Message) :
         messageType{type}, sourceId{src},destinationId{dest} {}
 
     /**
@@ -65,8 +85,31 @@ public:
      * @param cmd The command
      * @param type The message's type
      */
-    Message(const size_t& src, const size_t& dest, const DataType& cmd, const MessageType& type = MessageType::Message) :
-        messageType{type}, sourceId{src}, destinationId{dest}, message{cmd} {}
+    Message(const NodeId& src, const NodeId& dest, const DataType& cmd, const MessageType& type = MessageType::Message) :
+        messageType{type}, sourceId{src}, destinationId{dest}, message{cmd} {
+        parseCommand();
+    }
+
+    /**
+     * @brief Constructor of a published message
+     * @param src The source's id of the message
+     * @param topic The topic (delivered to its subscribers)
+     * @param data The text
+     * @param type The message's type
+     */
+    Message(const NodeId& src, const Topic& topic, const DataType& data, const MessageType& type = MessageType::Message) :
+        messageType{type}, sourceId{src}, messageTopic{topic}, message{data} {
+        parseCommand();
+    }
+
+    /**
+     * @brief Constructor of a typed command, without text
+     * @param src The source's id of the message
+     * @param dest The destination's id of the message
+     * @param cmd The typed command
+     */
+    Message(const NodeId& src, const NodeId& dest, const Command& cmd) :
+        messageType{MessageType::Command}, sourceId{src}, destinationId{dest}, command{cmd} {}
 
     /**
      * @brief Definition of the message
@@ -74,6 +117,7 @@ public:
      */
     void setMessage(const DataType& cmd) {
         message = cmd;
+        parseCommand();
     }
 
     /**
@@ -90,6 +134,7 @@ public:
      */
     void setType(const MessageType& type) {
         messageType = type;
+        parseCommand();
     }
 
     /**
@@ -99,17 +144,49 @@ public:
     [[nodiscard]] const MessageType& getType() const {
         return messageType;
     }
+    /**
+     * @brief Get the typed command (parsed from the text of Command and Input messages, again after each change)
+     * @return The typed command
+     */
+    [[nodiscard]] const Command& getCommand() const {
+        if (!commandParsed)
+            parseCommand();
+        return command;
+    }
+
+    /**
+     * @brief Give the command its id in the receiving node, and its text parameter's value
+     * @param id The command's id, as found in the node's command table
+     * @param arguments The argument keywords of the command
+     */
+    void resolveCommand(CommandId id, const ArgumentList& arguments);
+
+    /**
+     * @brief Get the words of the text, as views (no allocation)
+     * @param first Index of the first word to get
+     * @return The words
+     * @note The views are invalidated when the message is modified or destroyed
+     */
+    [[nodiscard]] Tokenizer::Range getWords(uint8_t first = 0) const;
+
     /**
      * @brief Get the base of the command (first word of full command)
      * @return The base command
      */
-    [[nodiscard]] DataType getBaseCommand() const;
+    [[nodiscard]] OString getBaseCommand() const;
 
     /**
      * @brief Get the param of the command (full command without first word)
      * @return The command's param
      */
-    [[nodiscard]] DataType getParamStr() const;
+    [[nodiscard]] OString getParamStr() const;
+
+    /**
+     * @brief Get the param of the command (full command without first word)
+     * @param arena The arena of the result (nullptr: heap)
+     * @return The command's param
+     */
+    [[nodiscard]] data::ArenaString getParamStr(data::Arena* arena) const;
 
     /**
      * @brief Does the command have parameters
@@ -117,9 +194,16 @@ public:
      */
     [[nodiscard]] bool hasParams() const;
 
+    /**
+     * @brief Does the message hold more words than a command can have
+     * @return True if the words after config::maxCommandTokens are dropped
+     */
+    [[nodiscard]] bool isTruncated() const;
+
     /**
      * @brief Get the list of parameters
      * @return The list of parameters
+     * @note Allocate: prefer getWords(1)
      */
     [[nodiscard]] MultipleData getParams() const;
 
@@ -127,7 +211,7 @@ public:
      * @brief Get the command
      * @return The command
      */
-    [[nodiscard]] const size_t& getSource() const {
+    [[nodiscard]] const NodeId& getSource() const {
         return sourceId;
     }
 
@@ -135,15 +219,31 @@ public:
      * @brief Get the command
      * @return The command
      */
-    [[nodiscard]] const size_t& getDestination() const {
+    [[nodiscard]] const NodeId& getDestination() const {
         return destinationId;
     }
 
+    /**
+     * @brief Get the topic
+     * @return The topic, Topic::None if not published
+     */
+    [[nodiscard]] const Topic& getTopic() const {
+        return messageTopic;
+    }
+
+    /**
+     * @brief Check if the message is published on a topic
+     * @return True if published
+     */
+    [[nodiscard]] bool isPublished() const {
+        return messageTopic != Topic::None;
+    }
+
     /**
      * @brief Clear the message
      */
     void clear() {
-        message.clear();
+        edit().clear();
     }
 
     /**
@@ -173,7 +273,7 @@ public:
      * @param myId The destination Id
      * @return True if good this destination
      */
-    [[nodiscard]] bool isForMe(const size_t& myId)const;
+    [[nodiscard]] bool isForMe(const NodeId& myId)const;
     /**
      * @brief Print a string
      * @param data The String to print
@@ -324,12 +424,39 @@ public:
 private:
     /// The message's type
     MessageType messageType = MessageType::Message;
-    /// The hash code of the source driver
-    size_t sourceId;
-    /// The hash code of the destination driver
-    size_t destinationId;
+    /// The id of the source driver
+    NodeId sourceId = broadcastId;
+    /// The id of the destination driver
+    NodeId destinationId = broadcastId;
+    /// The topic of a published message
+    Topic messageTopic = Topic::None;
     /// The content of the message
     DataType message;
+    /// The typed command
+    mutable Command command;
+    /// If the typed command is up to date with the text
+    mutable bool commandParsed = true;
+    /// Positions of the words in the text
+    mutable Tokenizer tokenizer;
+    /// If the positions are up to date
+    mutable bool tokenized = false;
+
+    /**
+     * @brief Get the words positions, tokenize the text if needed
+     * @return The words positions
+     */
+    const Tokenizer& tokens() const;
+
+    /**
+     * @brief Access to the text for modification (invalidate the words positions)
+     * @return The text
+     */
+    Payload& edit();
+
+    /**
+     * @brief Update the typed command from the text
+     */
+    void parseCommand() const;
 };
 
 }// namespace obd::core::driver
@@ -9,47 +9,186 @@
 #include "Messenger.h"
 
 #include "Manager.h"
+#include "core/timer/VirtualClock.h"
+#include "native/fakeArduino.h"
+#include <algorithm>
 #include <utility>
 
 namespace obd::core::driver {
 
+namespace {
+
+/**
+ * @brief Keep the best outcome of a delivery to several nodes
+ *
+ * Accepted, then Saturated, Refused, Unreachable.
+ * @param result The outcome so far
+ * @param nodeResult The outcome for one more node
+ */
+void keepBest(Delivery& result, const Delivery& nodeResult) {
+    if (nodeResult.status() < result.status())
+        result = nodeResult;
+}
+
+/**
+ * @brief Check that the lengths of all the lanes are powers of two
+ * @return True if the lanes can be masked
+ */
+constexpr bool laneLengthsValid() {
+    for (size_t length : config::messengerLaneLengths) {
+        if (length == 0 || (length & (length - 1)) != 0)
+            return false;
+    }
+    return true;
+}
+
+static_assert(laneLengthsValid(), "messengerLaneLengths must be powers of two");
+
+}// namespace
+
 Messenger::Messenger(std::shared_ptr<Manager> manager) :
     manager{std::move(manager)} {
+    size_t offset = 0;
+    for (size_t lane = 0; lane < lanes.size(); ++lane) {
+        lanes[lane].attach(laneStorage.data() + offset, config::messengerLaneLengths[lane]);
+        offset += config::messengerLaneLengths[lane];
+    }
+    letters.setPolicy(data::OverflowPolicy::DropOldest);
 }
 
-void Messenger::pushMessage(const Message& message) {
-    messages.push(message);
-    ++statistics.receivedMessages;
+Delivery Messenger::pushMessage(const Message& message) {
+    auto& lane = lanes[static_cast<size_t>(laneOf(message.getType()))];
+    if (lane.full() && lane.getPolicy() == data::OverflowPolicy::DropOldest)
+        deadLetter(lane.front().message, Delivery::Status::Saturated);
+    Delivery result = statistics.accountDelivery(lane.push(Pending{message, timer::now()}), size());
+    if (!result)
+        deadLetter(message, result.status());
+    return result;
+}
+
+size_t Messenger::size() const {
+    size_t total = 0;
+    for (const auto& lane : lanes)
+        total += lane.size();
+    return total;
+}
+
+void Messenger::setQueuePolicy(const data::OverflowPolicy& policy, size_t limit) {
+    for (auto& lane : lanes) {
+        lane.setPolicy(policy);
+        lane.setLimit(limit);
+    }
 }
 
 void Messenger::update() {
+    uint8_t remaining = maxFrameMessages;
+    // nodes found saturated in this frame: their messages wait for the next one
+    SaturatedNodes saturated;
+    // guaranteed budgets: the lower lanes still drain under a flood of urgent messages
+    for (size_t lane = 0; lane < lanes.size(); ++lane)
+        remaining -= drainLane(lane, std::min(remaining, config::messengerLaneBudgets[lane]), saturated);
+    // what is left of the frame budget goes to the most urgent lanes
+    for (size_t lane = 0; lane < lanes.size() && remaining > 0; ++lane)
+        remaining -= drainLane(lane, remaining, saturated);
+}
+
+uint8_t Messenger::drainLane(size_t lane, uint8_t budget, SaturatedNodes& saturated) {
+    auto& queue          = lanes[lane];
     uint8_t messageCount = 0;
-    while (!messages.empty()) {
-        if (sendMessage(messages.front())) {
+    // one clock read per lane and frame
+    uint64_t now = timer::now();
+    // a single pass: the deferred messages go back at the end of the lane
+    size_t waiting = queue.size();
+    for (; messageCount < budget && waiting > 0; --waiting) {
+        Pending& pending = queue.front();
+        bool unicast     = !pending.message.isForAll() && !pending.message.isPublished();
+        if (unicast && saturated.test(pending.message.getDestination())) {
+            // behind a message the node could not take: keeps the order for this node
+            defer(queue);
+            continue;
+        }
+        Delivery result = sendMessage(pending.message);
+        if (result) {
             ++messageCount;
             ++statistics.sentMessages;
+            statistics.laneLatency[lane].account(now - pending.timestamp);
+        } else if (result.saturated() && ++pending.attempts < deliveryAttempts(pending.message)) {
+            // backpressure: only this node's messages wait for the next frame
+            ++statistics.retriedMessages;
+            saturated.set(pending.message.getDestination());
+            defer(queue);
+            continue;
         } else {
             ++statistics.droppedMessage;
+            // the recipients of a broadcast or publication have their own letters
+            if (unicast || result.status() == Delivery::Status::Unreachable)
+                deadLetter(pending.message, result.status());
         }
-        // DROP unsent messages
-        messages.pop();
-        // limit the number of sent message per frame
-        if (messageCount >= maxFrameMessages)
-            break;
+        queue.pop();
     }
+    return messageCount;
+}
+
+void Messenger::defer(MessageQueue& queue) {
+    Pending pending = std::move(queue.front());
+    queue.pop();
+    queue.push(std::move(pending));
 }
 
-bool Messenger::sendMessage(const Message& message) {
+Delivery Messenger::sendMessage(const Message& message) {
     if (manager == nullptr)
-        return false;
-    bool sent = false;
-    for (auto& node : *manager) {
-        if (message.isForMe(node->type())) {
-            if (node->pushMessage(message))
-                sent = true;
+        return Delivery::Status::Unreachable;
+    if (message.isPublished()) {
+        // every subscriber gets a copy sharing the same text
+        Delivery result = Delivery::Status::Unreachable;
+        for (const auto& subscriber : subscribers(message.getTopic())) {
+            auto* node = manager->route(subscriber);
+            if (node != nullptr)
+                keepBest(result, deliverCopy(*node, message));
         }
+        return result;
+    }
+    if (!message.isForAll()) {
+        auto* node = manager->route(message.getDestination());
+        if (node == nullptr)
+            return Delivery::Status::Unreachable;
+        return node->pushMessage(message);
     }
-    return sent;
+    Delivery result = Delivery::Status::Unreachable;
+    for (auto* node : manager->broadcastList())
+        keepBest(result, deliverCopy(*node, message));
+    return result;
+}
+
+Delivery Messenger::deliverCopy(Node& node, const Message& message) {
+    Delivery result = node.pushMessage(message);
+    if (!result)
+        letters.push(DeadLetter{message, result.status(), node.id()});
+    return result;
+}
+
+uint8_t Messenger::deliveryAttempts(const Message& message) const {
+    if (message.isForAll() || message.isPublished() || manager == nullptr)
+        return 1;
+    auto* node = manager->route(message.getDestination());
+    return node == nullptr ? 1 : node->deliveryAttempts();
+}
+
+void Messenger::deadLetter(const Message& message, const Delivery::Status& reason) {
+    letters.push(DeadLetter{message, reason});
+}
+
+void Messenger::subscribe(const NodeId& nodeId, const Topic& topic) {
+    if (topic == Topic::None)
+        return;
+    auto& list = subscriptions[static_cast<size_t>(topic)];
+    if (std::find(list.begin(), list.end(), nodeId) == list.end())
+        list.push_back(nodeId);
+}
+
+void Messenger::unsubscribe(const NodeId& nodeId, const Topic& topic) {
+    auto& list = subscriptions[static_cast<size_t>(topic)];
+    list.erase(std::remove(list.begin(), list.end(), nodeId), list.end());
 }
 
 void Messenger::init() {
@@ -62,21 +201,26 @@ bool Messenger::check() {
     return Object::check();
 }
 
-OString Messenger::computeName(const size_t nodeId) {
-    if (nodeId == 0)
+OString Messenger::computeName(const NodeId& nodeId) const {
+    if (nodeId == broadcastId)
         return "All";
-    auto node = manager->getNode(nodeId);
-    if (node == nullptr)
+    if (manager == nullptr)
         return "Unknown";
-    return node->name();
+    return manager->nameOf(nodeId);
 }
-size_t Messenger::computeId(const OString& name) {
+
+NodeId Messenger::computeId(const OString& name) const {
     if (name == "All")
-        return 0;
-    auto node = manager->getNode(name);
-    if (node == nullptr)
-        return 0;
-    return node->type();
+        return broadcastId;
+    if (manager == nullptr)
+        return unknownId;
+    return manager->idOf(name);
+}
+
+NodeId Messenger::computeId(const size_t& typeHash) const {
+    if (manager == nullptr)
+        return unknownId;
+    return manager->idOf(typeHash);
 }
 
 std::vector<OString> Messenger::getDriverList() const {
@@ -86,4 +230,16 @@ std::vector<OString> Messenger::getDriverList() const {
     return nodes;
 }
 
+size_t Messenger::getDriverCount() const {
+    if (manager == nullptr)
+        return 0;
+    return manager->size();
+}
+
+Node* Messenger::getDriver(const NodeId& nodeId) const {
+    if (manager == nullptr)
+        return nullptr;
+    return manager->route(nodeId);
+}
+
 }// namespace obd::core::driver
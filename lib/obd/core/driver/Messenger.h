@@ -8,28 +8,94 @@
 
 #pragma once
 #include "Message.h"
+#include "Statistics.h"
 #include "core/base/Object.h"
+#include "data/RingBuffer.h"
+#include <bitset>
+#include <limits>
 #include <memory>
-#include <queue>
+#include <vector>
 
 namespace obd::core::driver {
 
 class Manager;
+class Node;
 
 /**
- * @brief Structure carrying stats
+ * @brief Get the number of slots of all the messenger's lanes
+ * @return The sum of the lanes' lengths
  */
-struct Statistics {
-    uint64_t receivedMessages = 0;///< Amount of received message
-    uint64_t sentMessages     = 0;///< Ammount of dropped message
-    uint64_t droppedMessage   = 0;///< Amount of dropped message
-};
+constexpr size_t laneSlots() {
+    size_t total = 0;
+    for (size_t length : config::messengerLaneLengths)
+        total += length;
+    return total;
+}
 
 /**
  * @brief Class to handle the message trafic
  */
 class Messenger : public base::Object {
 public:
+    /**
+     * @brief Priority lanes, from the most urgent
+     */
+    enum struct Lane : uint8_t {
+        Critical,  ///< Errors
+        Control,   ///< Commands and user inputs
+        Normal,    ///< Replies and warnings
+        Background,///< Console messages
+    };
+
+    /**
+     * @brief Message waiting in a lane
+     */
+    struct Pending {
+        Message message;       ///< The message
+        uint64_t timestamp = 0;///< Queuing time in microseconds
+        uint8_t attempts   = 0;///< Delivery attempts to a saturated target
+    };
+
+    /**
+     * @brief Message that could not be delivered
+     */
+    struct DeadLetter {
+        Message message;                                 ///< The message
+        Delivery::Status reason = Delivery::Status::Refused;///< Why it was not delivered
+        NodeId recipient        = unknownId;             ///< The recipient of a broadcast or publication that did not get its copy
+    };
+
+    /// Dead letter queue type (the oldest letters are discarded)
+    using DeadLetterQueue = data::RingBuffer<DeadLetter, config::deadLetterLength>;
+
+    /// Subscribers of a topic
+    using SubscriberList = std::vector<NodeId>;
+
+    /// Message queue type (one per lane, over a part of the lanes' storage)
+    using MessageQueue = data::RingQueue<Pending>;
+
+
+    /**
+     * @brief Get the lane of a message type
+     * @param type The message's type
+     * @return The lane
+     */
+    static constexpr Lane laneOf(const Message::MessageType& type) {
+        switch (type) {
+        case Message::MessageType::Error:
+            return Lane::Critical;
+        case Message::MessageType::Command:
+        case Message::MessageType::Input:
+            return Lane::Control;
+        case Message::MessageType::Reply:
+        case Message::MessageType::Warning:
+            return Lane::Normal;
+        case Message::MessageType::Message:
+            break;
+        }
+        return Lane::Background;
+    }
+
     /**
      * @brief Default constructor.
      * @param manager Link to the node manager
@@ -38,14 +104,23 @@ public:
 
     /**
      * @brief Add message to sending list
-     * @param message
+     *
+     * A message refused by its full lane, or discarded from it to make room
+     * (DropOldest), goes to the dead letter queue.
+     * @param message The message
+     * @return Accepted if queued, Saturated if the lane is full
      */
-    void pushMessage(const Message& message);
+    Delivery pushMessage(const Message& message);
 
     void init() override;
 
     /**
-     * @brief Update the treatment
+     * @brief Deliver the queued messages
+     *
+     * Each lane first gets its guaranteed budget (config::messengerLaneBudgets),
+     * so that the low priority lanes never starve; the remaining frame budget is
+     * then given to the lanes from the most urgent. A saturated node only delays
+     * its own messages, until the next frame.
      */
     void update() override;
 
@@ -55,7 +130,60 @@ public:
      * @brief Get the actual queue size
      * @return The queue size
      */
-    [[nodiscard]] size_t size() const { return messages.size(); }
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @brief Get the actual size of a lane
+     * @param lane The lane
+     * @return The lane size
+     */
+    [[nodiscard]] size_t size(const Lane& lane) const { return lanes[static_cast<size_t>(lane)].size(); }
+
+    /**
+     * @brief Define the behavior when the queue is full
+     * @param policy The overflow policy
+     * @param limit The effective queue capacity (0 means full capacity)
+     */
+    void setQueuePolicy(const data::OverflowPolicy& policy, size_t limit = 0);
+
+    /**
+     * @brief Keep an undelivered message for later inspection
+     * @param message The message
+     * @param reason Why it was not delivered
+     */
+    void deadLetter(const Message& message, const Delivery::Status& reason);
+
+    /**
+     * @brief Get the last undelivered messages
+     * @return The dead letters, the oldest first
+     */
+    [[nodiscard]] const DeadLetterQueue& deadLetters() const { return letters; }
+
+    /**
+     * @brief Forget the undelivered messages
+     */
+    void clearDeadLetters() { letters.clear(); }
+
+    /**
+     * @brief Deliver the messages published on a topic to a node
+     * @param nodeId The subscriber's id
+     * @param topic The topic
+     */
+    void subscribe(const NodeId& nodeId, const Topic& topic);
+
+    /**
+     * @brief Stop the delivery of a topic to a node
+     * @param nodeId The subscriber's id
+     * @param topic The topic
+     */
+    void unsubscribe(const NodeId& nodeId, const Topic& topic);
+
+    /**
+     * @brief Get the subscribers of a topic
+     * @param topic The topic
+     * @return The subscribers' ids, in subscription order
+     */
+    [[nodiscard]] const SubscriberList& subscribers(const Topic& topic) const { return subscriptions[static_cast<size_t>(topic)]; }
 
     /**
      * @brief Get the actual trafic statistics
@@ -68,36 +196,103 @@ public:
      * @param nodeId The nodeId
      * @return The name of node
      */
-    OString computeName(const size_t nodeId);
+    [[nodiscard]] OString computeName(const NodeId& nodeId) const;
 
     /**
      * @brief Compute the ID base on the name
-     * @param name The node's name
-     * @return The node's ID, return 0 if node not found
+     * @param name The node's name ("All" for every node)
+     * @return The node's ID, return unknownId if node not found
      */
-    size_t computeId(const OString& name);
+    [[nodiscard]] NodeId computeId(const OString& name) const;
+
+    /**
+     * @brief Compute the ID base on the node's type
+     * @param typeHash The node's type hash
+     * @return The node's ID, return unknownId if node not found
+     */
+    [[nodiscard]] NodeId computeId(const size_t& typeHash) const;
 
     /**
      * @brief
      * @return
      */
     std::vector<OString> getDriverList()const;
+
+    /**
+     * @brief Get the number of drivers (their ids go from 1 to this number)
+     * @return The number of drivers
+     */
+    [[nodiscard]] size_t getDriverCount() const;
+
+    /**
+     * @brief Get a driver for inspection
+     * @param nodeId The driver's id
+     * @return The driver or nullptr if not found
+     */
+    [[nodiscard]] Node* getDriver(const NodeId& nodeId) const;
 private:
     /// Maximum amount of message treated in one frame
     uint8_t maxFrameMessages = 10;
     /// Pointer to the Manager
     std::shared_ptr<Manager> manager;
-    /// Messages list
-    std::queue<Message> messages;
+    /// Messages lists, one per priority
+    std::array<MessageQueue, config::messengerLaneCount> lanes;
+    /// Storage of the lanes, one after the other
+    std::array<Pending, laneSlots()> laneStorage{};
+    /// Undelivered messages
+    DeadLetterQueue letters;
+    /// Subscribers of each topic
+    std::array<SubscriberList, topicCount> subscriptions;
     /// The stats
     Statistics statistics;
 
     /**
      * @brief Send the message to the designated target(s)
      * @param message The message
-     * @return True if message effectively sent
+     * @return Accepted if the message is sent (to at least one node for broadcast and publication,
+     * the others are dead-lettered)
+     */
+    Delivery sendMessage(const Message& message);
+
+    /**
+     * @brief Give a copy of a broadcast or published message to one recipient
+     *
+     * There is no retry for a copy: a recipient that does not accept it gets
+     * its own dead letter, whatever the other recipients do.
+     * @param node The recipient
+     * @param message The message
+     * @return The recipient's answer
+     */
+    Delivery deliverCopy(Node& node, const Message& message);
+
+    /**
+     * @brief Get the number of frames a message can wait for its saturated target
+     * @param message The message
+     * @return The number of attempts (1 for broadcast and publication: no retry)
+     */
+    [[nodiscard]] uint8_t deliveryAttempts(const Message& message) const;
+
+    /// Set of node ids
+    using SaturatedNodes = std::bitset<std::numeric_limits<NodeId>::max() + 1>;
+
+    /**
+     * @brief Deliver the messages of a lane, in one pass at most
+     *
+     * A message to a saturated node goes back at the end of the lane, with the
+     * following messages to the same node: the other destinations are not
+     * blocked behind it.
+     * @param lane Index of the lane
+     * @param budget Maximum amount of messages to deliver
+     * @param saturated The nodes found saturated in this frame, updated
+     * @return The amount of delivered messages
+     */
+    uint8_t drainLane(size_t lane, uint8_t budget, SaturatedNodes& saturated);
+
+    /**
+     * @brief Move the first message of a lane to its end
+     * @param queue The lane
      */
-    bool sendMessage(const Message& message);
+    static void defer(MessageQueue& queue);
 };
 
 }// namespace obd::core::driver
@@ -9,13 +9,24 @@
 #include "Node.h"
 #include "Messenger.h"
 #include "com/Shell.h"
+#include "core/timer/VirtualClock.h"
+#include "native/fakeArduino.h"
 #include <algorithm>
+#include <string_view>
 #include <utility>
 
 namespace obd::core::driver {
 
+static_assert((config::nodeQueueLength & (config::nodeQueueLength - 1)) == 0, "nodeQueueLength must be a power of two");
+
 Node::Node(std::shared_ptr<Messenger> messenger) :
-    messenger{std::move(messenger)} {
+    messenger{std::move(messenger)}, defaultStorage{new Message[config::nodeQueueLength]} {
+    messages.attach(defaultStorage.get(), config::nodeQueueLength);
+}
+
+Node::~Node() {
+    if (timerService != nullptr)
+        timerService->stopAll(this);
 }
 
 void Node::init() {
@@ -31,19 +42,35 @@ void Node::update() {
     Object::update();
     if (!initialized())
         return;
+    notified       = false;
+    uint64_t start = micros64();
     preTreatment();
+    uint64_t end = micros64();
+    nodeProfile.preTreatment.account(end - start);
+    bool hasMessages     = !messages.empty();
     uint8_t messageCount = 0;
     while (!messages.empty()) {
         if (treatMessage(messages.front())) {
             ++messageCount;
+        } else {
+            ++statistics.droppedMessage;
+            // an accepted command that cannot be executed is worth a look
+            if (messages.front().getType() == MessageType::Command)
+                messenger->deadLetter(messages.front(), Delivery::Status::Refused);
         }
-        // DROP unsent messages
         messages.pop();
-        // limit the number of sent message per frame
+        // limit the number of treated message per frame, the others wait in the queue
         if (messageCount >= maxFrameMessages)
             break;
     }
+    if (hasMessages) {
+        start = end;
+        end   = micros64();
+        nodeProfile.messages.account(end - start);
+    }
+    start = end;
     postTreatment();
+    nodeProfile.postTreatment.account(micros64() - start);
 }
 
 void Node::loadConfig() {
@@ -62,71 +89,228 @@ void Node::postTreatment() {
     // by default, do nothing
 }
 
-bool Node::pushMessage(const Message& message) {
+InitStatus Node::initStep() {
+    init();
+    return initialized() ? InitStatus::Done : InitStatus::Failed;
+}
+
+InitStatus Node::retryIn(uint64_t delay) {
+    initRetry = timer::now() + delay;
+    return InitStatus::Pending;
+}
+
+Delivery Node::pushMessage(const Message& message) {
     if (!initialized()) {
-        return false;
+        return Delivery::Status::Refused;
     }
     if (message.getType() != MessageType::Command) {
-        messages.push(message);
-        return true;
+        return queueMessage(message);
     }
-    if (!message.isForMe(type())) {
+    if (!message.isForMe(id())) {
         console("Bad Destination", MessageType::Warning);
-        return false;
+        return Delivery::Status::Refused;
     }
-    if (pushCommand(message)) {
-        return true;
+    Delivery result = pushCommand(message);
+    if (result == Delivery::Status::Refused)
+        console("Unknown Command", MessageType::Warning);
+    return result;
+}
+
+Delivery Node::pushCommand(const Message& message) {
+    if (findCommand(message) == nullptr) {
+        // Reject unsupported commands
+        return Delivery::Status::Refused;
     }
-    console("Unknown Command", MessageType::Warning);
+    return queueMessage(message);
+}
+
+Delivery Node::queueMessage(const Message& message) {
+    // the message discarded to make room is not lost silently
+    if (messages.full() && messages.getPolicy() == data::OverflowPolicy::DropOldest && messenger != nullptr)
+        messenger->deadLetter(messages.front(), Delivery::Status::Saturated);
+    return statistics.accountDelivery(messages.push(message), messages.size());
+}
+
+void Node::setQueuePolicy(const data::OverflowPolicy& policy, size_t limit) {
+    messages.setPolicy(policy);
+    messages.setLimit(limit);
+}
+
+void Node::setSchedule(uint64_t period, uint64_t budget) {
+    nodeSchedule.period = period;
+    nodeSchedule.budget = budget;
+}
+
+bool Node::ioReady() {
+    // by default, nothing to read
     return false;
 }
 
-bool Node::pushCommand(const Message& message) {
-    if (message.getBaseCommand() == "info") {
-        messages.push(message);
+bool Node::hasWork(uint64_t now) {
+    if (notified)
         return true;
-    }
-    // Reject all other commands
-    return false;
+    Wakeup events = nodeSchedule.wakeups;
+    if (hasWakeup(events, Wakeup::Message) && !messages.empty())
+        return true;
+    if (hasWakeup(events, Wakeup::Timer) && nodeSchedule.due(now))
+        return true;
+    return hasWakeup(events, Wakeup::Io) && ioReady();
+}
+
+Node::TimerId Node::startTimer(uint64_t delay, uint64_t period) {
+    if (timerService == nullptr)
+        return timer::TimerService::invalidTimer;
+    return timerService->start(delay, period, &Node::timerWakeup, this);
+}
+
+void Node::stopTimer(TimerId& timerId) {
+    if (timerService != nullptr)
+        timerService->stop(timerId);
+    timerId = timer::TimerService::invalidTimer;
+}
+
+uint16_t Node::timerExpired(TimerId timerId) {
+    if (timerService == nullptr)
+        return 0;
+    return timerService->consume(timerId);
 }
 
-OString Node::info() const {
+void Node::timerWakeup(void* node) {
+    static_cast<Node*>(node)->notify();
+}
+
+Message::DataType Node::info() const {
     // by default, do nothing
     return {};
 }
 
-void Node::broadcastMessage(const Message& message) const {
-    messenger->pushMessage(message);
+Delivery Node::broadcastMessage(const Message& message) const {
+    if (messenger == nullptr)
+        return Delivery::Status::Unreachable;
+    return messenger->pushMessage(message);
 }
 
 bool Node::treatMessage(const Message& message) {
-    if (message.getType() == MessageType::Command) {
-        if (message.getBaseCommand() == "info") {
-            broadcastMessage(message.getSource(), info(), MessageType::Reply);
-            return true;
+    if (message.getType() != MessageType::Command)
+        return false;
+    const Command& command    = message.getCommand();
+    const CommandEntry* entry = findCommand(message);
+    if (entry == nullptr)
+        return false;
+    // typed commands carry at most their argument
+    size_t paramCount = message.empty() ? (command.hasArgument() ? 1U : 0U) : message.getWords(1).size();
+    if (paramCount < entry->arity) {
+        Message msg{id(), message.getSource(), MessageType::Error};
+        msg.print(entry->keyword);
+        msg.print(": need a parameter");
+        broadcastMessage(msg);
+        return true;
+    }
+    if (message.empty() || (entry->id == command.id && entry->arguments.empty())) {
+        entry->handler(*this, message);
+        return true;
+    }
+    // text command of the node, or text parameter: give their values to the handler
+    Message resolved{message};
+    resolved.resolveCommand(entry->id, entry->arguments);
+    entry->handler(*this, resolved);
+    return true;
+}
+
+CommandTable Node::commands() const {
+    return {};
+}
+
+CommandTable Node::baseCommands() {
+    static constexpr CommandEntry table[] = {
+            {CommandId::Info, "info", 0, commandHandler<&Node::cmdInfo>(), "Print the node's information", {}},
+            {CommandId::Help, "help", 0, commandHandler<&Node::cmdHelp>(), "Print this help", {}},
+    };
+    static_assert(CommandTable::sorted(table), "commands must be sorted by id");
+    return table;
+}
+
+const CommandEntry* Node::findCommand(CommandId commandId) const {
+    const CommandEntry* entry = commands().find(commandId);
+    if (entry != nullptr)
+        return entry;
+    return baseCommands().find(commandId);
+}
+
+const CommandEntry* Node::findCommand(const Message& message) const {
+    const Command& command = message.getCommand();
+    if (command.id != CommandId::Unknown || message.empty())
+        return findCommand(command.id);
+    // the node's own keywords are not known by the parser
+    std::string_view keyword = message.getWords()[0];
+    for (const auto& entry : commands()) {
+        if (keyword == entry.keyword)
+            return &entry;
+    }
+    return nullptr;
+}
+
+void Node::cmdInfo(const Message& message) {
+    broadcastMessage(Message{id(), message.getSource(), info(), MessageType::Reply});
+}
+
+void Node::cmdHelp(const Message& message) {
+    // plain message: printed by the consoles
+    Message msg{id(), message.getSource(), MessageType::Message};
+    msg.print(name());
+    msg.println(" commands:");
+    for (const auto& table : {baseCommands(), commands()}) {
+        for (const auto& entry : table) {
+            msg.print(entry.keyword);
+            msg.print(" ");
+            msg.println(entry.help);
         }
     }
-    return false;
+    broadcastMessage(msg);
+}
+
+void Node::dependsOn(size_t nodeType) {
+    if (std::find(nodeDependencies.begin(), nodeDependencies.end(), nodeType) == nodeDependencies.end())
+        nodeDependencies.push_back(nodeType);
+}
+
+void Node::dependsOnOptional(size_t nodeType) {
+    if (std::find(nodeOptionalDependencies.begin(), nodeOptionalDependencies.end(), nodeType) == nodeOptionalDependencies.end())
+        nodeOptionalDependencies.push_back(nodeType);
 }
 
 bool Node::linkNode([[maybe_unused]] const std::shared_ptr<Node>& node) {
     return false;
 }
 
-void Node::broadcastMessage(const size_t& destination, const OString& msg, MessageType mtype) const {
-    broadcastMessage(Message{type(), destination, msg, mtype});
+Delivery Node::broadcastMessage(const NodeId& destination, const OString& msg, MessageType mtype) const {
+    return broadcastMessage(Message{id(), destination, msg, mtype});
 }
 
-size_t Node::getConsoleId() {
-    return typeid(com::Shell).hash_code();
+NodeId Node::getConsoleId() const {
+    if (messenger == nullptr)
+        return unknownId;
+    return messenger->computeId(typeid(com::Shell).hash_code());
 }
 
 void Node::console(const OString& msg, MessageType type) const {
     broadcastMessage(getConsoleId(), msg, type);
 }
 
-OString Node::computeName(const size_t nodeId) {
-    return messenger->computeName(nodeId);
+void Node::publish(const Topic& topic, const Message::DataType& msg, MessageType type) const {
+    broadcastMessage(Message{id(), topic, msg, type});
+}
+
+void Node::subscribe(const Topic& topic) {
+    messenger->subscribe(id(), topic);
+}
+
+void Node::unsubscribe(const Topic& topic) {
+    messenger->unsubscribe(id(), topic);
+}
+
+OString Node::computeName(const NodeId& otherId) {
+    return messenger->computeName(otherId);
 }
 
 }// namespace obd::core::driver
@@ -7,14 +7,30 @@
  */
 
 #pragma once
+#include "CommandTable.h"
 #include "Message.h"
+#include "Profile.h"
+#include "Schedule.h"
+#include "Statistics.h"
 #include "core/base/Object.h"
+#include "core/memory/MemoryTracker.h"
+#include "core/timer/TimerService.h"
+#include "data/RingBuffer.h"
+#include <array>
+#include <atomic>
 #include <memory>
-#include <queue>
+#include <utility>
+#include <vector>
+
+namespace obd::core {
+template<class... Nodes>
+class StaticSystem;
+}// namespace obd::core
 
 namespace obd::core::driver {
 
 class Messenger;
+class Manager;
 
 /**
  * @brief Node's category
@@ -26,6 +42,27 @@ enum struct Category {
     Communicator,
 };
 
+/**
+ * @brief State of a node's initialization, driven by the manager
+ */
+enum struct InitState : uint8_t {
+    Waiting,          ///< Not yet initialized
+    Pending,          ///< Initialization in progress
+    Done,             ///< Initialized
+    Failed,           ///< The node's init failed
+    MissingDependency,///< A dependency is not in the manager, or not initialized
+    Cycle,            ///< The node is in a dependency cycle, or depends on one
+};
+
+/**
+ * @brief Result of an initialization step
+ */
+enum struct InitStatus : uint8_t {
+    Pending,///< Not finished, call again later
+    Done,   ///< Initialized
+    Failed, ///< The initialization failed
+};
+
 /**
  * @brief Base generic class for driver
  */
@@ -36,7 +73,7 @@ public:
     Node(Node&&)      = delete;
     Node& operator=(const Node&) = delete;
     Node& operator=(Node&&) = delete;
-    ~Node()         override = default;
+    ~Node() override;
     /// Base Message type
     using Message = obd::core::driver::Message;
     /// Base Message type
@@ -45,6 +82,21 @@ public:
     using Messenger = obd::core::driver::Messenger;
     /// Node's category
     using Category = obd::core::driver::Category;
+    /// Node's id type
+    using NodeId = obd::core::driver::NodeId;
+    /// Typed command
+    using Command = obd::core::driver::Command;
+    /// Command's id
+    using CommandId = obd::core::driver::CommandId;
+    /// Message queue type
+    using MessageQueue = data::RingQueue<Message>;
+    /// Storage of a message queue of the given length (a power of two)
+    template<size_t queueLength>
+    using QueueStorage = std::array<Message, queueLength>;
+    /// Timer identifier
+    using TimerId = timer::TimerService::TimerId;
+    /// List of node's type hashes
+    using DependencyList = std::vector<size_t>;
     /**
      * @brief Default constructor.
      * @param messenger The link to the messenger system
@@ -56,12 +108,33 @@ public:
      */
     void init() override;
 
+    /**
+     * @brief Do a step of the initialization, without blocking
+     *
+     * The manager calls it at each frame until it is no longer Pending, after
+     * the delay asked with retryIn(). The last step calls init().
+     * @return The step's result, by default init() is the only step
+     */
+    virtual InitStatus initStep();
+
     /**
      * @brief Send a message to this driver
      * @param message The message to send
-     * @return True mean message caught.
+     * @return Accepted if message caught, Saturated if the queue is full, Refused otherwise
+     */
+    Delivery pushMessage(const Message& message);
+
+    /**
+     * @brief Get the number of frames the messenger offers a message to this node while saturated
+     * @return The number of delivery attempts
      */
-    bool pushMessage(const Message& message);
+    [[nodiscard]] uint8_t deliveryAttempts() const { return maxDeliveryAttempts; }
+
+    /**
+     * @brief Define the number of frames the messenger offers a message to this node while saturated
+     * @param attempts The number of delivery attempts (at least 1)
+     */
+    void setDeliveryAttempts(uint8_t attempts) { maxDeliveryAttempts = attempts == 0 ? 1 : attempts; }
 
     /**
      * @brief Get the size of the messages queue
@@ -69,11 +142,17 @@ public:
      */
     [[nodiscard]] size_t queueSize() const { return messages.size(); }
 
+    /**
+     * @brief Get the capacity of the messages queue
+     * @return The number of messages the queue can hold
+     */
+    [[nodiscard]] size_t queueCapacity() const { return messages.maxSize(); }
+
     /**
      * @brief Return the driver infos
-     * @return The driver's infos.
+     * @return The driver's infos (a long text is shared by the messages, not copied).
      */
-    [[nodiscard]] virtual OString info()const;
+    [[nodiscard]] virtual Message::DataType info()const;
 
     /**
      * @brief Frame Object
@@ -96,6 +175,47 @@ public:
      */
     [[nodiscard]] size_t messageSize() const { return messages.size(); }
 
+    /**
+     * @brief Get the queue statistics of this node
+     * @return The queue statistics
+     */
+    [[nodiscard]] const Statistics& stats() const { return statistics; }
+
+    /**
+     * @brief Get the scheduling parameters and execution measures of this node
+     * @return The schedule
+     */
+    [[nodiscard]] const Schedule& schedule() const { return nodeSchedule; }
+
+    /**
+     * @brief Get the execution times of this node's phases
+     * @return The profile
+     */
+    [[nodiscard]] const Profile& profile() const { return nodeProfile; }
+
+    /**
+     * @brief Forget the execution times
+     */
+    void resetProfile() { nodeProfile.reset(); }
+
+    /**
+     * @brief Get the heap used by the node (allocations made in its init and updates)
+     * @return The memory usage
+     */
+    [[nodiscard]] const memory::Usage& memoryUsage() const { return memory::Tracker::usage(nodeId); }
+
+    /**
+     * @brief Wake the node up at the next frame, whatever its wakeup events (safe from an interrupt)
+     */
+    void notify() { notified = true; }
+
+    /**
+     * @brief Check if one of the node's wakeup events occurred
+     * @param now The current date in microseconds
+     * @return True if the node has work to do
+     */
+    [[nodiscard]] bool hasWork(uint64_t now);
+
     /**
      * @brief Try to link the given node
      * @param node The node to link to this one
@@ -109,20 +229,207 @@ public:
      */
     [[nodiscard]] virtual Category category()const{return Category::None;}
 
+    /**
+     * @brief Get the node's id, as assigned by the manager
+     * @return Node's id
+     */
+    [[nodiscard]] const NodeId& id() const { return nodeId; }
+
+    /**
+     * @brief Get the nodes to initialize before this one
+     * @return The type hashes of the dependencies
+     */
+    [[nodiscard]] const DependencyList& dependencies() const { return nodeDependencies; }
+
+    /**
+     * @brief Get the nodes used when present
+     * @return The type hashes of the optional dependencies
+     */
+    [[nodiscard]] const DependencyList& optionalDependencies() const { return nodeOptionalDependencies; }
+
+    /**
+     * @brief Get the state of the node's initialization
+     * @return The init state
+     */
+    [[nodiscard]] const InitState& initState() const { return nodeInitState; }
 
 private:
+    friend class Manager;
+    template<class... Nodes>
+    friend class core::StaticSystem;
+    /**
+     * @brief Command 'info': reply the node's information
+     * @param message The command
+     */
+    void cmdInfo(const Message& message);
+
+    /**
+     * @brief Command 'help': reply the node's command list
+     * @param message The command
+     */
+    void cmdHelp(const Message& message);
+
+    /**
+     * @brief Get the commands common to all nodes
+     * @return The command table
+     */
+    static CommandTable baseCommands();
+
+    /// Id of the node in the manager
+    NodeId nodeId = unknownId;
     /// Maximum amount of message treated in one frame
     uint8_t maxFrameMessages = 3;
+    /// Number of delivery attempts when the queue is full
+    uint8_t maxDeliveryAttempts = config::deliveryAttempts;
     /// Pointer to messenger
     std::shared_ptr<Messenger> messenger = nullptr;
     /// List of messages
-    std::queue<Message> messages;
+    MessageQueue messages;
+    /// Storage of the queue when the derived node does not give one
+    std::unique_ptr<Message[]> defaultStorage;
+    /// Queue statistics
+    Statistics statistics;
+    /// Scheduling parameters and measures
+    Schedule nodeSchedule;
+    /// Execution times
+    Profile nodeProfile;
+    /// If the node has been woken up since the last run
+    std::atomic<bool> notified{false};
+    /// Timers of the manager
+    timer::TimerService* timerService = nullptr;
+    /// Nodes to initialize before this one
+    DependencyList nodeDependencies;
+    /// Nodes used when present
+    DependencyList nodeOptionalDependencies;
+    /// Initialization state
+    InitState nodeInitState = InitState::Waiting;
+    /// Date of the next initialization step
+    uint64_t initRetry = 0;
+
+    /**
+     * @brief Timer callback: wake the node up
+     * @param node The node
+     */
+    static void timerWakeup(void* node);
 protected:
+    /**
+     * @brief Constructor for the nodes choosing their queue's length at compile time
+     * @tparam queueLength Capacity of the queue (a power of two)
+     * @param messenger The link to the messenger system
+     * @param storage The queue's storage, a member of the derived node
+     */
+    template<size_t queueLength>
+    Node(std::shared_ptr<Messenger> messenger, QueueStorage<queueLength>& storage) :
+        messenger{std::move(messenger)} {
+        messages.attach(storage);
+    }
+
     /**
      * @brief Link to the message list
      * @return the message list
      */
-    std::queue<Message>& getMessages(){return messages;}
+    MessageQueue& getMessages(){return messages;}
+
+    /**
+     * @brief Add a message to the queue, accounting overflows
+     *
+     * With DropOldest, the discarded message goes to the messenger's dead letters.
+     * @param message The message to queue
+     * @return Accepted if the message is in the queue, Saturated otherwise
+     */
+    Delivery queueMessage(const Message& message);
+
+    /**
+     * @brief Define the behavior when the queue is full
+     * @param policy The overflow policy
+     * @param limit The effective queue capacity (0 means full capacity)
+     */
+    void setQueuePolicy(const data::OverflowPolicy& policy, size_t limit = 0);
+
+    /**
+     * @brief Declare the node's timing needs
+     * @param period Time between two runs in microseconds (0: every frame)
+     * @param budget Worst-case execution time of one run in microseconds
+     */
+    void setSchedule(uint64_t period, uint64_t budget = config::nodeBudget);
+
+    /**
+     * @brief Declare the events that make the node run
+     * @param events The wakeup events
+     */
+    void setWakeups(Wakeup events) { nodeSchedule.wakeups = events; }
+
+    /**
+     * @brief Ask for the next initialization step after a delay
+     * @param delay Time before the next step in microseconds
+     * @return Pending
+     */
+    InitStatus retryIn(uint64_t delay);
+
+    /**
+     * @brief Get the date asked for the next initialization step
+     * @return The date in microseconds
+     */
+    [[nodiscard]] uint64_t initRetryDate() const { return initRetry; }
+
+    /**
+     * @brief Declare a node to initialize before this one, the manager links them
+     * @param nodeType The type hash of the dependency
+     * @note Declare the dependencies in the constructor
+     */
+    void dependsOn(size_t nodeType);
+
+    /**
+     * @brief Declare a node to initialize before this one, the manager links them
+     * @tparam T The dependency's type
+     */
+    template<class T>
+    void dependsOn() { dependsOn(typeid(T).hash_code()); }
+
+    /**
+     * @brief Declare a node used when present, the manager links them once both are initialized
+     *
+     * The optional dependency starts first when the order allows it; a missing or
+     * failed one never blocks the initialization of this node.
+     * @param nodeType The type hash of the optional dependency
+     * @note Declare the dependencies in the constructor
+     */
+    void dependsOnOptional(size_t nodeType);
+
+    /**
+     * @brief Declare a node used when present, the manager links them once both are initialized
+     * @tparam T The optional dependency's type
+     */
+    template<class T>
+    void dependsOnOptional() { dependsOnOptional(typeid(T).hash_code()); }
+
+    /**
+     * @brief Check for input to read, for the nodes waking up on I/O
+     * @return True if input is available
+     */
+    [[nodiscard]] virtual bool ioReady();
+
+    /**
+     * @brief Start a timer that wakes the node up on expiry
+     * @param delay Time before the first expiry in microseconds
+     * @param period Time between the next expiries in microseconds (0: one-shot)
+     * @return The timer's id, invalidTimer if the node has no manager or all timers are used
+     * @note The node must be in a manager: start the timers in init()
+     */
+    TimerId startTimer(uint64_t delay, uint64_t period = 0);
+
+    /**
+     * @brief Stop a timer of the node
+     * @param timerId The timer's id, reset to invalidTimer
+     */
+    void stopTimer(TimerId& timerId);
+
+    /**
+     * @brief Get and reset the number of expiries of a timer since the last call
+     * @param timerId The timer's id
+     * @return The number of expiries
+     */
+    uint16_t timerExpired(TimerId timerId);
 
     /**
      * @brief Link to messenger
@@ -132,10 +439,31 @@ protected:
 
     /**
      * @brief Get the name from node Id
-     * @param nodeId The nodeId
+     * @param otherId The nodeId
      * @return The name of node
      */
-    OString computeName(const size_t nodeId);
+    OString computeName(const NodeId& otherId);
+
+    /**
+     * @brief Get the commands specific to this node
+     * @return The command table (sorted by id)
+     * @note The commands of the base node (info, help) are always accepted
+     */
+    [[nodiscard]] virtual CommandTable commands() const;
+
+    /**
+     * @brief Search a command in the node's table, then in the base node's one
+     * @param commandId The command's id
+     * @return The command or nullptr if not supported
+     */
+    [[nodiscard]] const CommandEntry* findCommand(CommandId commandId) const;
+
+    /**
+     * @brief Search the command of a message, by keyword if it is not a common one
+     * @param message The command
+     * @return The command or nullptr if not supported
+     */
+    [[nodiscard]] const CommandEntry* findCommand(const Message& message) const;
 
     /**
      * @brief What to do before message treatment
@@ -143,7 +471,7 @@ protected:
     virtual void preTreatment();
 
     /**
-     * @brief Treat the given message
+     * @brief Treat the given message, commands are dispatched through the command table
      * @param message The message to treat
      * @return True if message treated
      */
@@ -155,31 +483,33 @@ protected:
     virtual void postTreatment();
 
     /**
-     * @brief Send a message to this driver
+     * @brief Send a message to this driver, by default accept the commands of the table
      * @param message The Command message to send
-     * @return True mean command caught.
+     * @return Accepted if command caught, Saturated if the queue is full, Refused if unknown
      */
-    virtual bool pushCommand(const Message& message);
+    virtual Delivery pushCommand(const Message& message);
 
     /**
      * @brief Get the Id of the Shell
      * @return The shell Id
      */
-    static size_t getConsoleId();
+    [[nodiscard]] NodeId getConsoleId() const;
 
     /**
      * @brief Send a message to other
      * @param message The message to send
+     * @return Accepted if queued by the messenger, Saturated if its lane is full
      */
-    void broadcastMessage(const Message& message) const;
+    Delivery broadcastMessage(const Message& message) const;
 
     /**
      * @brief Send a message to other
      * @param destination The destination id
      * @param msg The message to send
      * @param type The message's type
+     * @return Accepted if queued by the messenger, Saturated if its lane is full
      */
-    void broadcastMessage(const size_t& destination,const OString& msg, Message::MessageType type=Message::MessageType::Message) const;
+    Delivery broadcastMessage(const NodeId& destination,const OString& msg, Message::MessageType type=Message::MessageType::Message) const;
 
     /**
      * @brief Push a console message
@@ -187,6 +517,26 @@ protected:
      * @param type The message's type
      */
     void console(const OString& msg, Message::MessageType type=Message::MessageType::Message) const;
+
+    /**
+     * @brief Send a message to the subscribers of a topic
+     * @param topic The topic
+     * @param msg The message to publish
+     * @param type The message's type
+     */
+    void publish(const Topic& topic, const Message::DataType& msg, Message::MessageType type = Message::MessageType::Message) const;
+
+    /**
+     * @brief Receive the messages published on a topic
+     * @param topic The topic
+     */
+    void subscribe(const Topic& topic);
+
+    /**
+     * @brief Stop receiving the messages of a topic
+     * @param topic The topic
+     */
+    void unsubscribe(const Topic& topic);
 };
 
 }// namespace obd::core::driver
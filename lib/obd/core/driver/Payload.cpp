@@ -0,0 +1,269 @@
+/**
+ * @file Payload.cpp
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "Payload.h"
+#include <array>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace obd::core::driver {
+
+namespace {
+
+/**
+ * @brief Static pool of blocks for the payloads too long for inline storage
+ * @note Not thread safe: only used from the main loop
+ */
+class BlockPool {
+public:
+    /**
+     * @brief Take a free block
+     * @return The block or nullptr if none available
+     */
+    char* take() {
+        for (size_t idx = 0; idx < config::payloadBlockCount; ++idx) {
+            if (!used[idx]) {
+                used[idx] = true;
+                return blocks[idx].data();
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Give back a block
+     * @param block The block to release
+     */
+    void give(const char* block) {
+        for (size_t idx = 0; idx < config::payloadBlockCount; ++idx) {
+            if (blocks[idx].data() == block) {
+                used[idx] = false;
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Get the amount of free blocks
+     * @return The amount of free blocks
+     */
+    [[nodiscard]] size_t freeBlocks() const {
+        size_t count = 0;
+        for (bool isUsed : used)
+            if (!isUsed) ++count;
+        return count;
+    }
+
+private:
+    /// Block storage (aligned for the header of the shared texts)
+    alignas(std::max_align_t) std::array<std::array<char, config::payloadBlockSize>, config::payloadBlockCount> blocks{};
+    /// Block usage
+    std::array<bool, config::payloadBlockCount> used{};
+};
+
+/**
+ * @brief Access to the pool
+ * @return The pool
+ */
+BlockPool& pool() {
+    static BlockPool blockPool;
+    return blockPool;
+}
+
+}// namespace
+
+Payload::Payload() :
+    buffer{inlineBuffer} {
+    inlineBuffer[0] = 0;
+}
+
+Payload::Payload(const char* str) :
+    Payload() {
+    append(str);
+}
+
+Payload::Payload(const OString& str) :
+    Payload() {
+    append(str.c_str(), static_cast<size_type>(str.length()));
+}
+
+Payload::Payload(const Payload& other) :
+    Payload() {
+    if (!share(other))
+        append(other.buffer, other.length);
+}
+
+Payload::Payload(Payload&& other) noexcept :
+    Payload() {
+    *this = std::move(other);
+}
+
+Payload& Payload::operator=(const Payload& other) {
+    if (this == &other || (storage != Storage::Inline && buffer == other.buffer))
+        return *this;
+    release();
+    clear();
+    if (!share(other))
+        append(other.buffer, other.length);
+    return *this;
+}
+
+Payload& Payload::operator=(Payload&& other) noexcept {
+    if (this == &other)
+        return *this;
+    if (other.storage == Storage::Inline) {
+        release();
+        clear();
+        append(other.buffer, other.length);
+    } else {
+        // steal the external storage
+        release();
+        buffer         = other.buffer;
+        length         = other.length;
+        capacity       = other.capacity;
+        storage        = other.storage;
+        other.buffer   = other.inlineBuffer;
+        other.capacity = inlineCapacity - 1;
+        other.storage  = Storage::Inline;
+    }
+    other.length    = 0;
+    other.buffer[0] = 0;
+    return *this;
+}
+
+Payload::~Payload() {
+    release();
+}
+
+void Payload::clear() {
+    if (useCount() > 1)
+        release();
+    length    = 0;
+    buffer[0] = 0;
+}
+
+void Payload::append(const char* str, size_type count) {
+    if (str == nullptr || count == 0)
+        return;
+    char* dest = grow(count);
+    if (dest == nullptr)
+        return;
+    std::memcpy(dest, str, count);
+}
+
+void Payload::append(const char* str) {
+    if (str == nullptr)
+        return;
+    append(str, static_cast<size_type>(std::strlen(str)));
+}
+
+void Payload::push_back(char chr) {
+    append(&chr, 1);
+}
+
+char* Payload::grow(size_type count) {
+    if (count > npos - 1 - length)
+        return nullptr;
+    if (!reserve(length + count))
+        return nullptr;
+    char* dest = buffer + length;
+    length += count;
+    buffer[length] = 0;
+    return dest;
+}
+
+Payload::size_type Payload::find(char chr, size_type from) const {
+    if (from >= length)
+        return npos;
+    const void* found = std::memchr(buffer + from, chr, length - from);
+    if (found == nullptr)
+        return npos;
+    return static_cast<size_type>(static_cast<const char*>(found) - buffer);
+}
+
+OString Payload::substr(size_type pos, size_type count) const {
+    if (pos >= length)
+        return {};
+    if (count > length - pos)
+        count = length - pos;
+    return OString(buffer + pos, count);
+}
+
+bool Payload::operator==(const char* str) const {
+    return std::strcmp(buffer, str == nullptr ? "" : str) == 0;
+}
+
+uint16_t Payload::useCount() const {
+    return storage == Storage::Inline ? 1 : header()->references;
+}
+
+size_t Payload::freePoolBlocks() {
+    return pool().freeBlocks();
+}
+
+bool Payload::reserve(size_type newLength) {
+    if (newLength <= capacity && useCount() == 1)
+        return true;
+    if (newLength < inlineCapacity) {
+        // shared text short enough: back to the inline buffer
+        std::memcpy(inlineBuffer, buffer, length + 1);
+        release();
+        return true;
+    }
+    char* block           = nullptr;
+    Storage newStorage    = Storage::Heap;
+    size_type newCapacity = 0;
+    if (newLength < config::payloadBlockSize - headerSize)
+        block = pool().take();
+    if (block != nullptr) {
+        newStorage  = Storage::Pool;
+        newCapacity = config::payloadBlockSize - headerSize - 1;
+    } else {
+        newCapacity = static_cast<size_type>(newLength < npos / 2 ? newLength * 2 : npos - 1);
+        block       = new char[headerSize + newCapacity + 1];
+    }
+    new (block) Shared{};
+    char* newBuffer = block + headerSize;
+    std::memcpy(newBuffer, buffer, length + 1);
+    release();
+    buffer   = newBuffer;
+    capacity = newCapacity;
+    storage  = newStorage;
+    return true;
+}
+
+Payload::Shared* Payload::header() const {
+    return std::launder(reinterpret_cast<Shared*>(buffer - headerSize));
+}
+
+bool Payload::share(const Payload& other) {
+    if (other.storage == Storage::Inline || other.header()->references == UINT16_MAX)
+        return false;
+    ++other.header()->references;
+    buffer   = other.buffer;
+    length   = other.length;
+    capacity = other.capacity;
+    storage  = other.storage;
+    return true;
+}
+
+void Payload::release() {
+    if (storage != Storage::Inline && --header()->references == 0) {
+        char* block = buffer - headerSize;
+        if (storage == Storage::Pool)
+            pool().give(block);
+        else
+            delete[] block;
+    }
+    buffer   = inlineBuffer;
+    capacity = inlineCapacity - 1;
+    storage  = Storage::Inline;
+}
+
+}// namespace obd::core::driver
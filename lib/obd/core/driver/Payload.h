@@ -0,0 +1,243 @@
+/**
+ * @file Payload.h
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "config.h"
+#include "native/OString.h"
+#include <cstdint>
+
+namespace obd::core::driver {
+
+/**
+ * @brief Text content of a message, with small buffer optimization
+ *
+ * Short texts are stored inside the object, longer ones spill into a block of
+ * a static pool (config::payloadBlockCount blocks of config::payloadBlockSize
+ * bytes). Only when the pool is exhausted or the text is larger than a block,
+ * the heap is used.
+ *
+ * The external storage starts with a reference counter: copies share it (a
+ * broadcast or a publication does not duplicate the text) and the first
+ * modification of a shared text makes a private copy.
+ */
+class Payload {
+public:
+    /// Size type
+    using size_type = uint16_t;
+    /// Value returned by find when nothing found
+    static constexpr size_type npos = UINT16_MAX;
+    /// Capacity of the inline storage (including the terminal null char)
+    static constexpr size_type inlineCapacity = config::messageInlineLength;
+
+    /**
+     * @brief Default constructor: empty text
+     */
+    Payload();
+    /**
+     * @brief Construct from C string
+     * @param str The string to copy
+     */
+    Payload(const char* str);// NOLINT(google-explicit-constructor)
+    /**
+     * @brief Construct from string
+     * @param str The string to copy
+     */
+    Payload(const OString& str);// NOLINT(google-explicit-constructor)
+    /**
+     * @brief Copy constructor
+     * @param other The payload to copy
+     */
+    Payload(const Payload& other);
+    /**
+     * @brief Move constructor
+     * @param other The payload to move
+     */
+    Payload(Payload&& other) noexcept;
+    /**
+     * @brief Copy assignment
+     * @param other The payload to copy
+     * @return this
+     */
+    Payload& operator=(const Payload& other);
+    /**
+     * @brief Move assignment
+     * @param other The payload to move
+     * @return this
+     */
+    Payload& operator=(Payload&& other) noexcept;
+    /**
+     * @brief Destructor, give back the storage
+     */
+    ~Payload();
+
+    /**
+     * @brief Get the text as null terminated string
+     * @return The text
+     */
+    [[nodiscard]] const char* c_str() const { return buffer; }
+
+    /**
+     * @brief Get the text as a string (allocate)
+     * @return The text
+     */
+    [[nodiscard]] OString str() const { return OString(buffer); }
+
+    /**
+     * @brief Get the text length
+     * @return The length
+     */
+    [[nodiscard]] size_type size() const { return length; }
+
+    /**
+     * @brief Check for emptiness
+     * @return True if empty
+     */
+    [[nodiscard]] bool empty() const { return length == 0; }
+
+    /**
+     * @brief Check if the text is in the inline storage
+     * @return True if inline
+     */
+    [[nodiscard]] bool isInline() const { return storage == Storage::Inline; }
+
+    /**
+     * @brief Get the number of payloads using the same text
+     * @return The number of users (1 for an inline text)
+     */
+    [[nodiscard]] uint16_t useCount() const;
+
+    /**
+     * @brief Get one char
+     * @param idx The char index
+     * @return The char
+     */
+    [[nodiscard]] char operator[](size_type idx) const { return buffer[idx]; }
+
+    /**
+     * @brief Empty the text (keep the storage if not shared)
+     */
+    void clear();
+
+    /**
+     * @brief Append some chars
+     * @param str The chars to append
+     * @param count The amount of chars
+     */
+    void append(const char* str, size_type count);
+
+    /**
+     * @brief Append a C string
+     * @param str The string to append
+     */
+    void append(const char* str);
+
+    /**
+     * @brief Append a char
+     * @param chr The char to append
+     */
+    void push_back(char chr);
+
+    /**
+     * @brief Extend the text by count uninitialized chars
+     * @param count The amount of chars to add
+     * @return Pointer to the first added char (count+1 chars writable), nullptr if impossible
+     */
+    char* grow(size_type count);
+
+    /**
+     * @brief Append a C string
+     * @param str The string to append
+     * @return this
+     */
+    Payload& operator+=(const char* str) {
+        append(str);
+        return *this;
+    }
+
+    /**
+     * @brief Search for a char
+     * @param chr The char to find
+     * @param from Where to start the search
+     * @return Position of the char or npos
+     */
+    [[nodiscard]] size_type find(char chr, size_type from = 0) const;
+
+    /**
+     * @brief Extract a part of the text (allocate)
+     * @param pos Start of the part
+     * @param count Length of the part
+     * @return The sub string
+     */
+    [[nodiscard]] OString substr(size_type pos, size_type count = npos) const;
+
+    /**
+     * @brief Compare with a C string
+     * @param str The string to compare
+     * @return True if identical
+     */
+    bool operator==(const char* str) const;
+
+    /**
+     * @brief Get the amount of free blocks in the spill pool
+     * @return The amount of free blocks
+     */
+    static size_t freePoolBlocks();
+
+private:
+    /// Kind of storage in use
+    enum struct Storage : uint8_t {
+        Inline,///< Internal buffer
+        Pool,  ///< Block of the static pool
+        Heap,  ///< Dynamic allocation
+    };
+    /**
+     * @brief Header of the external storage, before the text
+     */
+    struct Shared {
+        uint16_t references = 1;///< Number of payloads using the text
+    };
+    /// Size of the header in the external storage
+    static constexpr size_type headerSize = sizeof(Shared);
+    /// Pointer to the actual text
+    char* buffer;
+    /// Length of the text
+    size_type length = 0;
+    /// Capacity of the actual storage (without the terminal null char)
+    size_type capacity = inlineCapacity - 1;
+    /// Kind of storage in use
+    Storage storage = Storage::Inline;
+    /// Inline storage
+    char inlineBuffer[inlineCapacity];
+
+    /**
+     * @brief Make sure the storage can contain the given length and is not shared
+     * @param newLength The needed text length
+     * @return True if storage is large enough
+     */
+    bool reserve(size_type newLength);
+
+    /**
+     * @brief Get the header of the external storage
+     * @return The header
+     */
+    [[nodiscard]] Shared* header() const;
+
+    /**
+     * @brief Use the external storage of another payload
+     * @param other The payload to share with
+     * @return False if the text cannot be shared (inline or too many users)
+     */
+    bool share(const Payload& other);
+
+    /**
+     * @brief Give back the storage and return to the inline buffer
+     */
+    void release();
+};
+
+}// namespace obd::core::driver
@@ -0,0 +1,135 @@
+/**
+ * @file Profile.h
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "config.h"
+#include <array>
+#include <cstdint>
+
+namespace obd::core::driver {
+
+/**
+ * @brief Fixed size histogram of durations, with power of 2 buckets
+ *
+ * Bucket N holds the values of N bits: [2^(N-1), 2^N - 1], bucket 0 holds 0 and the
+ * last one everything above. Minimum, maximum and mean are exact, the percentiles
+ * are the upper bound of their bucket.
+ */
+class Histogram {
+public:
+    /// Number of buckets
+    static constexpr uint8_t bucketCount = config::profileBuckets;
+
+    /**
+     * @brief Account a sample
+     * @param value The duration in microseconds
+     */
+    void account(uint64_t value) {
+        ++buckets[bucketOf(value)];
+        ++samples;
+        total += value;
+        if (samples == 1 || value < minimum)
+            minimum = value;
+        if (value > maximum)
+            maximum = value;
+    }
+
+    /**
+     * @brief Forget all the samples
+     */
+    void reset() { *this = Histogram{}; }
+
+    /**
+     * @brief Get the amount of samples
+     * @return The amount of samples
+     */
+    [[nodiscard]] uint64_t count() const { return samples; }
+
+    /**
+     * @brief Get the lowest sample
+     * @return The lowest sample (0 if empty)
+     */
+    [[nodiscard]] uint64_t min() const { return minimum; }
+
+    /**
+     * @brief Get the highest sample
+     * @return The highest sample (0 if empty)
+     */
+    [[nodiscard]] uint64_t max() const { return maximum; }
+
+    /**
+     * @brief Get the mean of the samples
+     * @return The mean (0 if empty)
+     */
+    [[nodiscard]] uint64_t average() const { return samples == 0 ? 0 : total / samples; }
+
+    /**
+     * @brief Get an upper bound of a percentile
+     * @param percent The percentile (99 for p99)
+     * @return The value under which are the given percentage of the samples
+     */
+    [[nodiscard]] uint64_t percentile(uint8_t percent) const {
+        if (samples == 0)
+            return 0;
+        // rank of the sample, rounded up
+        uint64_t rank       = (samples * percent + 99) / 100;
+        uint64_t cumulative = 0;
+        for (uint8_t idx = 0; idx < bucketCount; ++idx) {
+            cumulative += buckets[idx];
+            if (cumulative >= rank && idx + 1 < bucketCount) {
+                uint64_t upper = idx == 0 ? 0 : (uint64_t{1} << idx) - 1;
+                return upper < maximum ? upper : maximum;
+            }
+        }
+        return maximum;
+    }
+
+private:
+    /**
+     * @brief Get the bucket of a value: its number of significant bits
+     * @param value The value
+     * @return The bucket's index
+     */
+    static uint8_t bucketOf(uint64_t value) {
+        if (value == 0)
+            return 0;
+        auto bits = static_cast<uint8_t>(64 - __builtin_clzll(value));
+        return bits < bucketCount ? bits : bucketCount - 1;
+    }
+
+    /// Amount of samples per bucket
+    std::array<uint32_t, bucketCount> buckets{};
+    /// Amount of samples
+    uint64_t samples = 0;
+    /// Sum of the samples
+    uint64_t total = 0;
+    /// Lowest sample
+    uint64_t minimum = 0;
+    /// Highest sample
+    uint64_t maximum = 0;
+};
+
+/**
+ * @brief Execution times of the phases of a node's frame
+ */
+struct Profile {
+    Histogram preTreatment; ///< Time spent in preTreatment
+    Histogram messages;     ///< Time spent treating messages (only frames with messages)
+    Histogram postTreatment;///< Time spent in postTreatment
+
+    /**
+     * @brief Forget all the samples
+     */
+    void reset() {
+        preTreatment.reset();
+        messages.reset();
+        postTreatment.reset();
+    }
+};
+
+}// namespace obd::core::driver
@@ -0,0 +1,103 @@
+/**
+ * @file Schedule.h
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "config.h"
+#include <cstdint>
+
+namespace obd::core::driver {
+
+/**
+ * @brief Events that make a node ready to run (can be combined)
+ */
+enum struct Wakeup : uint8_t {
+    None    = 0,///< Never run
+    Message = 1,///< A message is waiting in the queue
+    Timer   = 2,///< The periodic deadline is reached (period 0: every frame)
+    Io      = 4,///< The node reports input to read (ioReady)
+};
+
+/**
+ * @brief Combine wakeup events
+ * @param left First events
+ * @param right Second events
+ * @return Both events
+ */
+constexpr Wakeup operator|(Wakeup left, Wakeup right) {
+    return static_cast<Wakeup>(static_cast<uint8_t>(left) | static_cast<uint8_t>(right));
+}
+
+/**
+ * @brief Check if an event is in a combination
+ * @param events The combination
+ * @param event The event to search
+ * @return True if the event is present
+ */
+constexpr bool hasWakeup(Wakeup events, Wakeup event) {
+    return (static_cast<uint8_t>(events) & static_cast<uint8_t>(event)) != 0;
+}
+
+/**
+ * @brief Scheduling parameters and execution measures of a node
+ *
+ * The manager runs a node when one of its wakeup events occurs, earliest deadline
+ * first, and accounts the measured execution time against the declared budget.
+ */
+struct Schedule {
+    Wakeup wakeups    = Wakeup::Message | Wakeup::Timer;///< Events making the node ready
+    uint64_t period   = 0;///< Time between two runs in microseconds (0: every frame)
+    uint64_t budget   = config::nodeBudget;///< Declared worst-case execution time in microseconds
+    uint64_t deadline = 0;///< Date of the next periodic run in microseconds
+    uint64_t runs     = 0;///< Amount of runs
+    uint64_t deferred = 0;///< Amount of runs postponed to the next frame (frame budget exhausted)
+    uint64_t overruns = 0;///< Amount of runs longer than the budget
+    uint64_t lastTime = 0;///< Execution time of the last run in microseconds
+    uint64_t maxTime  = 0;///< Longest execution time in microseconds
+    uint64_t total    = 0;///< Sum of the execution times in microseconds
+    uint64_t maxLate  = 0;///< Highest delay between the deadline and the run in microseconds
+    bool overrun      = false;///< If the last run exceeded the budget
+
+    /**
+     * @brief Check if the periodic run is due
+     * @param now The current date in microseconds
+     * @return True if the deadline is reached
+     */
+    [[nodiscard]] bool due(uint64_t now) const { return deadline <= now; }
+
+    /**
+     * @brief Account a run and compute the next deadline
+     * @param start The date of the run's start in microseconds
+     * @param duration The execution time in microseconds
+     */
+    void account(uint64_t start, uint64_t duration) {
+        ++runs;
+        lastTime = duration;
+        total += duration;
+        if (duration > maxTime)
+            maxTime = duration;
+        overrun = duration > budget;
+        if (overrun)
+            ++overruns;
+        if (!due(start))
+            return;// run only for the messages: keep the periodic deadline
+        if (period > 0 && runs > 1 && start - deadline > maxLate)
+            maxLate = start - deadline;
+        deadline += period;
+        // too late: skip the missed periods instead of bursting
+        if (deadline <= start)
+            deadline = start + period;
+    }
+
+    /**
+     * @brief Get the mean execution time
+     * @return The mean execution time in microseconds
+     */
+    [[nodiscard]] uint64_t average() const { return runs == 0 ? 0 : total / runs; }
+};
+
+}// namespace obd::core::driver
@@ -0,0 +1,102 @@
+/**
+ * @file Statistics.h
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "Delivery.h"
+#include "config.h"
+#include "data/RingBuffer.h"
+#include <array>
+#include <cstdint>
+
+namespace obd::core::driver {
+
+/**
+ * @brief Delivery latency of messages (from queuing to delivery)
+ */
+struct Latency {
+    uint64_t count = 0;///< Amount of delivered messages
+    uint64_t total = 0;///< Sum of the latencies in microseconds
+    uint64_t max   = 0;///< Highest latency in microseconds
+
+    /**
+     * @brief Account a delivery
+     * @param latency The latency in microseconds
+     */
+    void account(uint64_t latency) {
+        ++count;
+        total += latency;
+        if (latency > max)
+            max = latency;
+    }
+
+    /**
+     * @brief Get the mean latency
+     * @return The mean latency in microseconds
+     */
+    [[nodiscard]] uint64_t average() const { return count == 0 ? 0 : total / count; }
+};
+
+/**
+ * @brief Structure carrying stats
+ */
+struct Statistics {
+    uint64_t receivedMessages = 0;///< Amount of received message
+    uint64_t sentMessages     = 0;///< Ammount of dropped message
+    uint64_t droppedMessage   = 0;///< Amount of dropped message
+    uint64_t droppedOldest    = 0;///< Amount of queued message discarded to make room (overflow)
+    uint64_t droppedNewest    = 0;///< Amount of incoming message silently discarded (overflow)
+    uint64_t rejectedMessages = 0;///< Amount of incoming message refused (overflow)
+    uint64_t maxQueueSize     = 0;///< Highest queue length reached
+    uint64_t retriedMessages  = 0;///< Amount of delivery postponed because the target was saturated
+    /// Delivery latency per priority lane (only filled by the messenger)
+    std::array<Latency, config::messengerLaneCount> laneLatency{};
+
+    /**
+     * @brief Account the result of a queue insertion
+     * @param result The insertion result
+     * @param queueSize The queue size after insertion
+     * @return True if the element is in the queue
+     */
+    bool account(const data::PushResult& result, uint64_t queueSize) {
+        ++receivedMessages;
+        if (queueSize > maxQueueSize)
+            maxQueueSize = queueSize;
+        switch (result) {
+        case data::PushResult::Pushed:
+            return true;
+        case data::PushResult::DroppedOldest:
+            ++droppedOldest;
+            return true;
+        case data::PushResult::DroppedNewest:
+            ++droppedNewest;
+            return false;
+        case data::PushResult::Rejected:
+            ++rejectedMessages;
+            return false;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Account the result of a queue insertion
+     * @param result The insertion result
+     * @param queueSize The queue size after insertion
+     * @return Accepted if the element is in the queue, Saturated otherwise
+     */
+    Delivery accountDelivery(const data::PushResult& result, uint64_t queueSize) {
+        return account(result, queueSize) ? Delivery::Status::Accepted : Delivery::Status::Saturated;
+    }
+
+    /**
+     * @brief Get the total amount of message lost by queue overflow
+     * @return Amount of message lost by overflow
+     */
+    [[nodiscard]] uint64_t overflowMessages() const { return droppedOldest + droppedNewest + rejectedMessages; }
+};
+
+}// namespace obd::core::driver
@@ -0,0 +1,42 @@
+/**
+ * @file Tokenizer.cpp
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "Tokenizer.h"
+
+namespace obd::core::driver {
+
+void Tokenizer::parse(const char* text, size_type length) {
+    clear();
+    size_type pos = 0;
+    while (pos < length) {
+        if (text[pos] == ' ') {
+            ++pos;
+            continue;
+        }
+        Span span;
+        char separator = ' ';
+        if (text[pos] == '"') {
+            span.quoted = true;
+            separator   = '"';
+            ++pos;
+        }
+        span.start = pos;
+        while (pos < length && text[pos] != separator) ++pos;
+        span.length = static_cast<size_type>(pos - span.start);
+        // skip the closing quote
+        if (span.quoted && pos < length)
+            ++pos;
+        if (count >= maxTokens) {
+            truncated = true;
+            return;
+        }
+        spans[count++] = span;
+    }
+}
+
+}// namespace obd::core::driver
@@ -0,0 +1,194 @@
+/**
+ * @file Tokenizer.h
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "config.h"
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace obd::core::driver {
+
+/**
+ * @brief Split a command text into words, without allocation
+ *
+ * Words are separated by spaces; a word starting with a double quote runs up
+ * to the next double quote (or the end of the text) and may contain spaces.
+ * Only the positions of the words are stored, so the spans stay valid when the
+ * text is copied or moved along with its message.
+ */
+class Tokenizer {
+public:
+    /// Size type
+    using size_type = uint16_t;
+    /// Maximum number of words
+    static constexpr uint8_t maxTokens = config::maxCommandTokens;
+
+    /**
+     * @brief Position of a word in the text
+     */
+    struct Span {
+        size_type start  = 0;///< Position of the first char (after the quote)
+        size_type length = 0;///< Number of chars (without the quotes)
+        bool quoted      = false;///< If the word was quoted
+    };
+
+    /**
+     * @brief Iterable list of the words, as views on the text
+     */
+    class Range {
+    public:
+        /**
+         * @brief Iterator over the words
+         */
+        class Iterator {
+        public:
+            /**
+             * @brief Constructor
+             * @param txt The text
+             * @param spn The current span
+             */
+            Iterator(const char* txt, const Span* spn) :
+                text{txt}, span{spn} {}
+            /**
+             * @brief Access to the word
+             * @return The word
+             */
+            std::string_view operator*() const { return {text + span->start, span->length}; }
+            /**
+             * @brief Go to the next word
+             * @return this
+             */
+            Iterator& operator++() {
+                ++span;
+                return *this;
+            }
+            /**
+             * @brief Compare iterators
+             * @param other The other iterator
+             * @return True if different
+             */
+            bool operator!=(const Iterator& other) const { return span != other.span; }
+
+        private:
+            /// The text
+            const char* text;
+            /// The current span
+            const Span* span;
+        };
+
+        /**
+         * @brief Constructor
+         * @param txt The tokenized text
+         * @param first The first span
+         * @param cnt The number of spans
+         */
+        Range(const char* txt, const Span* first, uint8_t cnt) :
+            text{txt}, spans{first}, count{cnt} {}
+        /**
+         * @brief Iterator on the first word
+         * @return Iterator
+         */
+        [[nodiscard]] Iterator begin() const { return {text, spans}; }
+        /**
+         * @brief Iterator after the last word
+         * @return Iterator
+         */
+        [[nodiscard]] Iterator end() const { return {text, spans + count}; }
+        /**
+         * @brief Number of words
+         * @return The number of words
+         */
+        [[nodiscard]] uint8_t size() const { return count; }
+        /**
+         * @brief Check for emptiness
+         * @return True if no words
+         */
+        [[nodiscard]] bool empty() const { return count == 0; }
+        /**
+         * @brief Access to a word
+         * @param idx The word's index
+         * @return The word (empty if out of range)
+         */
+        [[nodiscard]] std::string_view operator[](uint8_t idx) const {
+            if (idx >= count)
+                return {};
+            return {text + spans[idx].start, spans[idx].length};
+        }
+
+    private:
+        /// The text
+        const char* text;
+        /// The first span
+        const Span* spans;
+        /// The number of spans
+        uint8_t count;
+    };
+
+    /**
+     * @brief Locate the words of a text
+     * @param text The text
+     * @param length The text's length
+     */
+    void parse(const char* text, size_type length);
+
+    /**
+     * @brief Forget all the words
+     */
+    void clear() {
+        count     = 0;
+        truncated = false;
+    }
+
+    /**
+     * @brief Number of words found
+     * @return The number of words
+     */
+    [[nodiscard]] uint8_t size() const { return count; }
+
+    /**
+     * @brief Check for emptiness
+     * @return True if no words
+     */
+    [[nodiscard]] bool empty() const { return count == 0; }
+
+    /**
+     * @brief Access to the position of a word
+     * @param idx The word's index (must be lower than size())
+     * @return The span
+     */
+    [[nodiscard]] const Span& operator[](uint8_t idx) const { return spans[idx]; }
+
+    /**
+     * @brief Check if some words were ignored (more than maxTokens)
+     * @return True if words were ignored
+     */
+    [[nodiscard]] bool isTruncated() const { return truncated; }
+
+    /**
+     * @brief Get the words of the given text
+     * @param text The tokenized text
+     * @param first Index of the first word
+     * @return The words
+     */
+    [[nodiscard]] Range range(const char* text, uint8_t first = 0) const {
+        if (first > count)
+            first = count;
+        return {text, spans.data() + first, static_cast<uint8_t>(count - first)};
+    }
+
+private:
+    /// The word positions
+    std::array<Span, maxTokens> spans{};
+    /// The number of words
+    uint8_t count = 0;
+    /// If words were ignored
+    bool truncated = false;
+};
+
+}// namespace obd::core::driver
@@ -0,0 +1,33 @@
+/**
+ * @file Topic.h
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace obd::core::driver {
+
+/**
+ * @brief Subjects of the published messages
+ *
+ * A published message is delivered to the nodes subscribed to its topic,
+ * whatever its destination.
+ */
+enum struct Topic : uint8_t {
+    None,     ///< Not published: sent to its destination
+    Log,      ///< Console messages
+    Warning,  ///< Console warnings
+    Error,    ///< Console errors
+    Telemetry,///< Vehicle measures
+    Camera,   ///< Camera state
+};
+
+/// Number of topics (None included)
+constexpr size_t topicCount = 6;
+
+}// namespace obd::core::driver
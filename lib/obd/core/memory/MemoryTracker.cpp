@@ -0,0 +1,205 @@
+/**
+ * @file MemoryTracker.cpp
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "MemoryTracker.h"
+#include "native/fakeArduino.h"
+#include <array>
+#include <cstdlib>
+#include <new>
+
+namespace obd::core::memory {
+
+namespace {
+
+// plain data only: the allocations may start before the dynamic initializations
+
+/// Usage of each owner
+std::array<Usage, config::memoryOwners> owners{};
+
+/// Usage of all the owners
+Usage totalUsage{};
+
+/// Owner of the new allocations
+Owner currentOwner = 0;
+
+/// Lowest free heap seen
+size_t lowestHeap = SIZE_MAX;
+
+/**
+ * @brief Get the slot of an owner
+ * @param owner The owner
+ * @return The slot's index
+ */
+size_t slotOf(Owner owner) {
+    return owner < config::memoryOwners ? owner : config::memoryOwners - 1;
+}
+
+}// namespace
+
+void Tracker::allocate(size_t size, Owner owner) {
+    owners[slotOf(owner)].allocate(size);
+    totalUsage.allocate(size);
+}
+
+void Tracker::release(size_t size, Owner owner) {
+    owners[slotOf(owner)].release(size);
+    totalUsage.release(size);
+}
+
+Owner Tracker::owner() {
+    return currentOwner;
+}
+
+const Usage& Tracker::usage(Owner owner) {
+    return owners[slotOf(owner)];
+}
+
+const Usage& Tracker::total() {
+    return totalUsage;
+}
+
+void Tracker::resetPeaks() {
+    for (auto& usage : owners)
+        usage.peak = usage.live;
+    totalUsage.peak = totalUsage.live;
+    lowestHeap      = SIZE_MAX;
+    sample();
+}
+
+size_t Tracker::freeHeap() {
+#ifdef ESP8266
+    return ESP.getFreeHeap();
+#else
+    return 0;
+#endif
+}
+
+size_t Tracker::lowestFreeHeap() {
+    return lowestHeap == SIZE_MAX ? 0 : lowestHeap;
+}
+
+uint8_t Tracker::fragmentation() {
+#ifdef ESP8266
+    return ESP.getHeapFragmentation();
+#else
+    return 0;
+#endif
+}
+
+void Tracker::setOwner(Owner owner) {
+    currentOwner = owner;
+}
+
+size_t Tracker::sample() {
+    size_t heap = freeHeap();
+    if (heap != 0 && heap < lowestHeap)
+        lowestHeap = heap;
+    return heap;
+}
+
+Scope::Scope(Owner owner) :
+    previous{Tracker::owner()}, startHeap{Tracker::sample()} {
+    Tracker::setOwner(owner);
+}
+
+Scope::~Scope() {
+    size_t endHeap = Tracker::sample();
+    // without allocation hooks, the heap variation is the best estimation
+    if (endHeap < startHeap)
+        Tracker::allocate(startHeap - endHeap, Tracker::owner());
+    else if (endHeap > startHeap)
+        Tracker::release(endHeap - startHeap, Tracker::owner());
+    Tracker::setOwner(previous);
+}
+
+}// namespace obd::core::memory
+
+#ifndef ARDUINO
+
+namespace {
+
+/**
+ * @brief Hidden header of the tracked allocations
+ */
+struct alignas(std::max_align_t) Header {
+    size_t size                    = 0;///< Requested bytes
+    obd::core::memory::Owner owner = 0;///< Owner at allocation
+};
+
+/**
+ * @brief Allocate and account memory
+ * @param size The bytes to allocate
+ * @return The memory, nullptr if exhausted
+ */
+void* trackedAllocate(size_t size) {
+    void* block = std::malloc(sizeof(Header) + size);
+    if (block == nullptr)
+        return nullptr;
+    auto* header = new (block) Header{size, obd::core::memory::Tracker::owner()};
+    obd::core::memory::Tracker::allocate(size, header->owner);
+    return header + 1;
+}
+
+/**
+ * @brief Account and release memory
+ * @param memory The memory given by trackedAllocate
+ */
+void trackedRelease(void* memory) {
+    if (memory == nullptr)
+        return;
+    auto* header = static_cast<Header*>(memory) - 1;
+    obd::core::memory::Tracker::release(header->size, header->owner);
+    std::free(header);
+}
+
+}// namespace
+
+void* operator new(size_t size) {
+    void* memory = trackedAllocate(size);
+    if (memory == nullptr)
+        throw std::bad_alloc();
+    return memory;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t& /*tag*/) noexcept {
+    return trackedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& /*tag*/) noexcept {
+    return trackedAllocate(size);
+}
+
+void operator delete(void* memory) noexcept {
+    trackedRelease(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    trackedRelease(memory);
+}
+
+void operator delete(void* memory, size_t /*size*/) noexcept {
+    trackedRelease(memory);
+}
+
+void operator delete[](void* memory, size_t /*size*/) noexcept {
+    trackedRelease(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t& /*tag*/) noexcept {
+    trackedRelease(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t& /*tag*/) noexcept {
+    trackedRelease(memory);
+}
+
+#endif
@@ -0,0 +1,158 @@
+/**
+ * @file MemoryTracker.h
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "config.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace obd::core::memory {
+
+/// Owner of the memory: id of the running node, 0 outside of any node
+using Owner = uint8_t;
+
+/**
+ * @brief Memory used by an owner
+ */
+struct Usage {
+    int64_t live         = 0;///< Bytes allocated and not released
+    int64_t peak         = 0;///< Highest live bytes since the last reset
+    uint64_t allocations = 0;///< Amount of allocations
+    uint64_t releases    = 0;///< Amount of releases
+
+    /**
+     * @brief Account an allocation
+     * @param size The allocated bytes
+     */
+    void allocate(size_t size) {
+        ++allocations;
+        live += static_cast<int64_t>(size);
+        if (live > peak)
+            peak = live;
+    }
+
+    /**
+     * @brief Account a release
+     * @param size The released bytes
+     */
+    void release(size_t size) {
+        ++releases;
+        live -= static_cast<int64_t>(size);
+    }
+};
+
+/**
+ * @brief Heap usage per owner
+ *
+ * On native, the global new and delete are replaced: each allocation is
+ * attributed to the owner running when it was made, even when released by
+ * another one. On ESP8266, the free heap is compared before and after each
+ * scope: the difference is attributed to the scope's owner, and the lowest
+ * free heap is kept. The owners from config::memoryOwners - 1 share the last slot.
+ */
+class Tracker {
+public:
+    /**
+     * @brief Account an allocation
+     * @param size The allocated bytes
+     * @param owner The owner
+     */
+    static void allocate(size_t size, Owner owner);
+
+    /**
+     * @brief Account a release
+     * @param size The released bytes
+     * @param owner The owner of the allocation
+     */
+    static void release(size_t size, Owner owner);
+
+    /**
+     * @brief Get the current owner
+     * @return The owner
+     */
+    [[nodiscard]] static Owner owner();
+
+    /**
+     * @brief Get the usage of an owner
+     * @param owner The owner
+     * @return The usage
+     */
+    [[nodiscard]] static const Usage& usage(Owner owner);
+
+    /**
+     * @brief Get the usage of all the owners
+     * @return The usage
+     */
+    [[nodiscard]] static const Usage& total();
+
+    /**
+     * @brief Restart the peak measures from the live bytes
+     */
+    static void resetPeaks();
+
+    /**
+     * @brief Get the free heap
+     * @return The free bytes (0 if unknown)
+     */
+    [[nodiscard]] static size_t freeHeap();
+
+    /**
+     * @brief Get the lowest free heap seen since the last reset
+     * @return The free bytes (0 if unknown)
+     */
+    [[nodiscard]] static size_t lowestFreeHeap();
+
+    /**
+     * @brief Get the heap fragmentation
+     * @return The fragmentation in percent (0 if unknown)
+     */
+    [[nodiscard]] static uint8_t fragmentation();
+
+private:
+    friend class Scope;
+
+    /**
+     * @brief Change the current owner
+     * @param owner The new owner
+     */
+    static void setOwner(Owner owner);
+
+    /**
+     * @brief Update the lowest free heap
+     * @return The free heap
+     */
+    static size_t sample();
+};
+
+/**
+ * @brief Attribute the memory to an owner while alive (scopes must not be nested on ESP8266)
+ */
+class Scope {
+public:
+    /**
+     * @brief Constructor
+     * @param owner The owner of the allocations in the scope
+     */
+    explicit Scope(Owner owner);
+    Scope(const Scope&) = delete;
+    Scope(Scope&&)      = delete;
+    Scope& operator=(const Scope&) = delete;
+    Scope& operator=(Scope&&) = delete;
+    /**
+     * @brief Destructor: back to the previous owner
+     */
+    ~Scope();
+
+private:
+    /// The owner before the scope
+    Owner previous;
+    /// Free heap at the scope's start
+    size_t startHeap = 0;
+};
+
+}// namespace obd::core::memory
@@ -0,0 +1,202 @@
+/**
+ * @file TimerService.cpp
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "TimerService.h"
+#include "VirtualClock.h"
+#include <algorithm>
+
+namespace obd::core::timer {
+
+namespace {
+
+/**
+ * @brief Convert a duration into ticks, rounded up, at least one tick
+ * @param duration The duration in microseconds
+ * @return The number of ticks
+ */
+uint64_t toTicks(uint64_t duration) {
+    uint64_t ticks = (duration + config::timerTick - 1) / config::timerTick;
+    return ticks == 0 ? 1 : ticks;
+}
+
+}// namespace
+
+TimerService::TimerService() {
+    slots.fill(none);
+    for (uint8_t idx = 0; idx < config::timerCount; ++idx)
+        timers[idx].next = idx + 1 < config::timerCount ? idx + 1 : none;
+}
+
+TimerService::TimerId TimerService::start(uint64_t delay, uint64_t period, Callback callback, void* context) {
+    if (freeList == none)
+        return invalidTimer;
+    // nothing depends on the wheel's position: catch up with the time
+    if (runningCount == 0)
+        currentTick = std::max(currentTick, now() / config::timerTick);
+    TimerId id = freeList;
+    freeList   = timers[id].next;
+
+    Timer& timer   = timers[id];
+    timer          = Timer{};
+    timer.expiry   = currentTick + toTicks(delay);
+    timer.period   = period == 0 ? 0 : toTicks(period);
+    timer.callback = callback;
+    timer.context  = context;
+    timer.used     = true;
+    timer.active   = true;
+    ++runningCount;
+    insert(id);
+    return id;
+}
+
+bool TimerService::stop(TimerId id) {
+    if (id >= config::timerCount || !timers[id].used)
+        return false;
+    Timer& timer   = timers[id];
+    bool wasActive = timer.active;
+    if (wasActive) {
+        unlink(id);
+        --runningCount;
+    }
+    timer.used   = false;
+    timer.active = false;
+    timer.next   = freeList;
+    freeList     = id;
+    return wasActive;
+}
+
+void TimerService::stopAll(const void* context) {
+    for (uint8_t idx = 0; idx < config::timerCount; ++idx) {
+        if (timers[idx].used && timers[idx].context == context)
+            stop(idx);
+    }
+}
+
+uint16_t TimerService::consume(TimerId id) {
+    if (id >= config::timerCount || !timers[id].used)
+        return 0;
+    uint16_t fired   = timers[id].fired;
+    timers[id].fired = 0;
+    // an expired one-shot timer is released once read
+    if (!timers[id].active)
+        stop(id);
+    return fired;
+}
+
+bool TimerService::running(TimerId id) const {
+    return id < config::timerCount && timers[id].used && timers[id].active;
+}
+
+void TimerService::advance(uint64_t date) {
+    uint64_t target = date / config::timerTick;
+    while (currentTick < target) {
+        if (runningCount == 0) {
+            currentTick = target;
+            return;
+        }
+        // jump to the next occupied slot of the first level, or to its wrap
+        uint64_t slot  = currentTick & slotMask;
+        uint64_t ahead = slot == slotMask ? 0 : occupied[0] & (~uint64_t{0} << (slot + 1));
+        uint64_t next  = ahead != 0 ? (currentTick & ~slotMask) + static_cast<uint64_t>(__builtin_ctzll(ahead)) : (currentTick | slotMask) + 1;
+        if (next > target) {
+            currentTick = target;
+            return;
+        }
+        currentTick = next;
+        if ((currentTick & slotMask) == 0) {
+            for (uint8_t level = 1; level < levelCount; ++level) {
+                cascade(level);
+                if (((currentTick >> (slotBits * level)) & slotMask) != 0)
+                    break;
+            }
+        }
+        expire();
+    }
+}
+
+uint64_t TimerService::idleTime() const {
+    if (runningCount == 0)
+        return UINT64_MAX;
+    uint64_t slot  = currentTick & slotMask;
+    uint64_t ahead = slot == slotMask ? 0 : occupied[0] & (~uint64_t{0} << (slot + 1));
+    uint64_t next  = ahead != 0 ? (currentTick & ~slotMask) + static_cast<uint64_t>(__builtin_ctzll(ahead)) : (currentTick | slotMask) + 1;
+    uint64_t date  = now();
+    uint64_t wake  = next * config::timerTick;
+    return wake > date ? wake - date : 0;
+}
+
+void TimerService::insert(TimerId id) {
+    Timer& timer   = timers[id];
+    uint64_t delta = timer.expiry - currentTick;
+    uint64_t place = timer.expiry;
+    // too far: park at the end of the wheel, it will be moved again
+    if (delta >= wheelSpan) {
+        delta = wheelSpan - 1;
+        place = currentTick + delta;
+    }
+    uint8_t level = 0;
+    while (delta >= (uint64_t{1} << (slotBits * (level + 1))))
+        ++level;
+    uint64_t slot = (place >> (slotBits * level)) & slotMask;
+    uint8_t index = static_cast<uint8_t>(level * slotCount + slot);
+    timer.slot     = index;
+    timer.previous = none;
+    timer.next     = slots[index];
+    if (timer.next != none)
+        timers[timer.next].previous = id;
+    slots[index] = id;
+    occupied[level] |= uint64_t{1} << slot;
+}
+
+void TimerService::unlink(TimerId id) {
+    Timer& timer  = timers[id];
+    uint8_t index = timer.slot;
+    if (timer.previous != none)
+        timers[timer.previous].next = timer.next;
+    else
+        slots[index] = timer.next;
+    if (timer.next != none)
+        timers[timer.next].previous = timer.previous;
+    if (slots[index] == none)
+        occupied[index / slotCount] &= ~(uint64_t{1} << (index & slotMask));
+    timer.slot     = none;
+    timer.next     = none;
+    timer.previous = none;
+}
+
+void TimerService::cascade(uint8_t level) {
+    auto index = static_cast<uint8_t>(level * slotCount + ((currentTick >> (slotBits * level)) & slotMask));
+    while (slots[index] != none) {
+        TimerId id = slots[index];
+        unlink(id);
+        insert(id);
+    }
+}
+
+void TimerService::expire() {
+    auto index = static_cast<uint8_t>(currentTick & slotMask);
+    while (slots[index] != none) {
+        TimerId id   = slots[index];
+        Timer& timer = timers[id];
+        unlink(id);
+        if (timer.fired < UINT16_MAX)
+            ++timer.fired;
+        if (timer.period != 0) {
+            timer.expiry += timer.period;
+            insert(id);
+        } else {
+            timer.active = false;
+            --runningCount;
+        }
+        // last: the callback may stop or start timers
+        if (timer.callback != nullptr)
+            timer.callback(timer.context);
+    }
+}
+
+}// namespace obd::core::timer
@@ -0,0 +1,162 @@
+/**
+ * @file TimerService.h
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "config.h"
+#include <array>
+#include <cstdint>
+
+namespace obd::core::timer {
+
+/**
+ * @brief One-shot and periodic timers in a hierarchical timing wheel
+ *
+ * Four levels of 64 slots: level N holds the timers expiring in less than
+ * 64^(N+1) ticks, and a slot is moved to the lower level when the time reaches it.
+ * Start, stop and expiry are O(1), the timers come from a fixed pool (no allocation).
+ * The delays count from the last advance. An expired one-shot timer keeps its id
+ * until consume() or stop().
+ */
+class TimerService {
+public:
+    /// Timer identifier
+    using TimerId = uint8_t;
+    /// Function called on expiry
+    using Callback = void (*)(void* context);
+    /// Invalid timer
+    static constexpr TimerId invalidTimer = 0xFF;
+
+    /**
+     * @brief Constructor
+     */
+    TimerService();
+
+    /**
+     * @brief Start a timer
+     * @param delay Time before the first expiry in microseconds
+     * @param period Time between the next expiries in microseconds (0: one-shot)
+     * @param callback Function called on each expiry (can be nullptr)
+     * @param context Parameter of the callback, also identifies the owner
+     * @return The timer's id, invalidTimer if all the timers are used
+     */
+    TimerId start(uint64_t delay, uint64_t period = 0, Callback callback = nullptr, void* context = nullptr);
+
+    /**
+     * @brief Stop a timer
+     * @param id The timer's id
+     * @return True if the timer was running
+     */
+    bool stop(TimerId id);
+
+    /**
+     * @brief Stop all the timers of an owner
+     * @param context The owner, as given at start
+     */
+    void stopAll(const void* context);
+
+    /**
+     * @brief Get and reset the number of expiries since the last call
+     * @param id The timer's id
+     * @return The number of expiries
+     */
+    uint16_t consume(TimerId id);
+
+    /**
+     * @brief Check if a timer is running (a one-shot timer stops on expiry)
+     * @param id The timer's id
+     * @return True if running
+     */
+    [[nodiscard]] bool running(TimerId id) const;
+
+    /**
+     * @brief Expire the timers up to the given date
+     * @param date The current date in microseconds
+     */
+    void advance(uint64_t date);
+
+    /**
+     * @brief Get a lower bound of the time before the next expiry, from now()
+     * @return The time in microseconds, UINT64_MAX if no timer is running
+     */
+    [[nodiscard]] uint64_t idleTime() const;
+
+    /**
+     * @brief Get the number of running timers
+     * @return The number of running timers
+     */
+    [[nodiscard]] uint8_t size() const { return runningCount; }
+
+private:
+    /// Number of levels
+    static constexpr uint8_t levelCount = 4;
+    /// Bits of slot index per level
+    static constexpr uint8_t slotBits = 6;
+    /// Number of slots per level
+    static constexpr uint8_t slotCount = 1U << slotBits;
+    /// Mask of the slot index
+    static constexpr uint64_t slotMask = slotCount - 1;
+    /// Farthest expiry the wheel can hold, in ticks
+    static constexpr uint64_t wheelSpan = uint64_t{1} << (slotBits * levelCount);
+    /// End of a slot's list
+    static constexpr uint8_t none = 0xFF;
+    static_assert(config::timerCount < none, "too many timers for the 8 bits ids");
+
+    /**
+     * @brief A timer
+     */
+    struct Timer {
+        uint64_t expiry   = 0;///< Expiry tick
+        uint64_t period   = 0;///< Period in ticks (0: one-shot)
+        Callback callback = nullptr;///< Function called on expiry
+        void* context     = nullptr;///< Parameter of the callback
+        uint16_t fired    = 0;///< Expiries since the last consume
+        uint8_t next      = none;///< Next timer in the slot (or in the free list)
+        uint8_t previous  = none;///< Previous timer in the slot
+        uint8_t slot      = none;///< Index of the slot in the wheel
+        bool used         = false;///< If owned (running, or expired one-shot not yet consumed)
+        bool active       = false;///< If running
+    };
+
+    /**
+     * @brief Put a running timer in the slot matching its expiry
+     * @param id The timer's id
+     */
+    void insert(TimerId id);
+
+    /**
+     * @brief Take a timer out of its slot
+     * @param id The timer's id
+     */
+    void unlink(TimerId id);
+
+    /**
+     * @brief Move the timers of the current slot of a level to the lower levels
+     * @param level The level
+     */
+    void cascade(uint8_t level);
+
+    /**
+     * @brief Expire the timers of the current slot of the first level
+     */
+    void expire();
+
+    /// The timers
+    std::array<Timer, config::timerCount> timers{};
+    /// First timer of each slot, level by level
+    std::array<uint8_t, levelCount * slotCount> slots{};
+    /// Non empty slots, one bit per slot
+    std::array<uint64_t, levelCount> occupied{};
+    /// First unused timer
+    uint8_t freeList = 0;
+    /// Number of running timers
+    uint8_t runningCount = 0;
+    /// Current tick
+    uint64_t currentTick = 0;
+};
+
+}// namespace obd::core::timer
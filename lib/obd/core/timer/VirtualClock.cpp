@@ -0,0 +1,62 @@
+/**
+ * @file VirtualClock.cpp
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "VirtualClock.h"
+#include "native/fakeArduino.h"
+
+namespace obd::core::timer {
+
+namespace {
+
+/// If the virtual time is used
+bool virtualEnabled = false;
+
+/// The virtual date in microseconds
+uint64_t virtualTime = 0;
+
+/// Time added to the real time so that the date never goes back after a virtual period
+uint64_t realOffset = 0;
+
+}// namespace
+
+uint64_t now() {
+    return virtualEnabled ? virtualTime : micros64() + realOffset;
+}
+
+void idle(uint64_t duration) {
+    if (virtualEnabled || duration < 1000)
+        return;
+    delay(static_cast<uint32_t>(duration / 1000));
+}
+
+void VirtualClock::enable() {
+    if (virtualEnabled)
+        return;
+    // keep the continuity with the real time
+    virtualTime    = micros64() + realOffset;
+    virtualEnabled = true;
+}
+
+void VirtualClock::disable() {
+    if (!virtualEnabled)
+        return;
+    uint64_t real = micros64() + realOffset;
+    if (virtualTime > real)
+        realOffset += virtualTime - real;
+    virtualEnabled = false;
+}
+
+bool VirtualClock::enabled() {
+    return virtualEnabled;
+}
+
+void VirtualClock::advance(uint64_t delta) {
+    virtualTime += delta;
+}
+
+}// namespace obd::core::timer
@@ -0,0 +1,57 @@
+/**
+ * @file VirtualClock.h
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include <cstdint>
+
+namespace obd::core::timer {
+
+/**
+ * @brief Get the current date used by the scheduler and the timers
+ * @return The date in microseconds: micros64(), or the virtual time when enabled
+ */
+uint64_t now();
+
+/**
+ * @brief Wait for the given time, without waiting while the virtual clock is enabled
+ * @param duration The time to wait in microseconds (precision: milliseconds)
+ */
+void idle(uint64_t duration);
+
+/**
+ * @brief Clock that tests can advance deterministically
+ *
+ * While enabled, now() only moves with advance(). When disabled, now() follows
+ * the real time again without going back.
+ */
+class VirtualClock {
+public:
+    /**
+     * @brief Freeze the time at the current date
+     */
+    static void enable();
+
+    /**
+     * @brief Back to the real time
+     */
+    static void disable();
+
+    /**
+     * @brief Check if the virtual time is used
+     * @return True if enabled
+     */
+    [[nodiscard]] static bool enabled();
+
+    /**
+     * @brief Move the virtual time forward
+     * @param delta The time to add in microseconds
+     */
+    static void advance(uint64_t delta);
+};
+
+}// namespace obd::core::timer
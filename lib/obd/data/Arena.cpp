@@ -0,0 +1,46 @@
+/**
+ * @file Arena.cpp
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "Arena.h"
+
+namespace obd::data {
+
+namespace {
+
+/// Arena of the running frame
+Arena* frameArena = nullptr;
+
+}// namespace
+
+void* Arena::allocate(size_t size, size_t alignment) {
+    size_t start = (offset + alignment - 1) & ~(alignment - 1);
+    if (start > buffer.size() || size > buffer.size() - start) {
+        ++overflowCount;
+        return nullptr;
+    }
+    offset = start + size;
+    if (offset > highest)
+        highest = offset;
+    return buffer.data() + start;
+}
+
+Arena* Arena::current() {
+    return frameArena;
+}
+
+ArenaScope::ArenaScope(Arena& frame) :
+    arena{frame}, previous{frameArena} {
+    frameArena = &frame;
+}
+
+ArenaScope::~ArenaScope() {
+    arena.reset();
+    frameArena = previous;
+}
+
+}// namespace obd::data
@@ -0,0 +1,195 @@
+/**
+ * @file Arena.h
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "config.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace obd::data {
+
+/**
+ * @brief Bump allocator for the temporaries of one frame
+ *
+ * Allocating is moving a pointer, releasing does nothing: all the memory is
+ * given back at once by reset(). The memory must not be used after the reset.
+ */
+class Arena {
+public:
+    /**
+     * @brief Get some memory
+     * @param size The amount of bytes
+     * @param alignment The alignment (power of 2)
+     * @return The memory, nullptr if the arena is full
+     */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Check if some memory comes from this arena
+     * @param memory The memory
+     * @return True if in the arena
+     */
+    [[nodiscard]] bool owns(const void* memory) const {
+        const auto* byte = static_cast<const uint8_t*>(memory);
+        return byte >= buffer.data() && byte < buffer.data() + buffer.size();
+    }
+
+    /**
+     * @brief Give back all the memory (the peak is kept)
+     */
+    void reset() { offset = 0; }
+
+    /**
+     * @brief Get the used bytes
+     * @return The used bytes
+     */
+    [[nodiscard]] size_t used() const { return offset; }
+
+    /**
+     * @brief Get the highest used bytes
+     * @return The highest used bytes
+     */
+    [[nodiscard]] size_t peak() const { return highest; }
+
+    /**
+     * @brief Get the size of the arena
+     * @return The capacity in bytes
+     */
+    [[nodiscard]] static constexpr size_t capacity() { return config::frameArenaSize; }
+
+    /**
+     * @brief Get the amount of allocations refused because the arena was full
+     * @return The amount of refused allocations
+     */
+    [[nodiscard]] uint32_t overflows() const { return overflowCount; }
+
+    /**
+     * @brief Get the arena of the running frame
+     * @return The arena, nullptr outside of a frame
+     */
+    [[nodiscard]] static Arena* current();
+
+private:
+    friend class ArenaScope;
+    /// The memory
+    alignas(std::max_align_t) std::array<uint8_t, config::frameArenaSize> buffer{};
+    /// First free byte
+    size_t offset = 0;
+    /// Highest offset
+    size_t highest = 0;
+    /// Refused allocations
+    uint32_t overflowCount = 0;
+};
+
+/**
+ * @brief Make an arena the current one, and reset it at the end of the scope
+ */
+class ArenaScope {
+public:
+    /**
+     * @brief Constructor
+     * @param frame The arena of the frame
+     */
+    explicit ArenaScope(Arena& frame);
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope(ArenaScope&&)      = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+    ArenaScope& operator=(ArenaScope&&) = delete;
+    /**
+     * @brief Destructor: reset the arena and restore the previous one
+     */
+    ~ArenaScope();
+
+private:
+    /// The arena of the scope
+    Arena& arena;
+    /// The arena before the scope
+    Arena* previous;
+};
+
+/**
+ * @brief Standard allocator using an arena, or the heap when there is no arena or it is full
+ * @tparam T The allocated type
+ */
+template<class T>
+class ArenaAllocator {
+public:
+    /// Allocated type
+    using value_type = T;
+
+    /**
+     * @brief Constructor
+     * @param source The arena (nullptr: heap), always given so the lifetime of the data is explicit
+     */
+    explicit ArenaAllocator(Arena* source) noexcept :
+        arena{source} {}
+
+    /**
+     * @brief Conversion from another allocated type
+     * @param other The other allocator
+     */
+    template<class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept :// NOLINT(google-explicit-constructor)
+        arena{other.arena} {}
+
+    /**
+     * @brief Allocate elements
+     * @param count The amount of elements
+     * @return The memory
+     */
+    T* allocate(size_t count) {
+        void* memory = arena == nullptr ? nullptr : arena->allocate(count * sizeof(T), alignof(T));
+        if (memory == nullptr)
+            memory = ::operator new(count * sizeof(T));
+        return static_cast<T*>(memory);
+    }
+
+    /**
+     * @brief Release elements (only the ones from the heap)
+     * @param memory The memory
+     */
+    void deallocate(T* memory, size_t /*count*/) noexcept {
+        if (arena == nullptr || !arena->owns(memory))
+            ::operator delete(memory);
+    }
+
+    /**
+     * @brief Compare allocators
+     * @param other The other allocator
+     * @return True if the memory of one can be released by the other
+     */
+    template<class U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+
+    /**
+     * @brief Compare allocators
+     * @param other The other allocator
+     * @return True if the memory of one cannot be released by the other
+     */
+    template<class U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+
+private:
+    template<class U>
+    friend class ArenaAllocator;
+    /// The arena
+    Arena* arena;
+};
+
+/// Vector of frame temporaries
+template<class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+/// String of frame temporaries
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+}// namespace obd::data
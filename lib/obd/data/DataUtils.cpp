@@ -83,4 +83,31 @@ OString merge(const std::vector<OString>& strings,
     return merge(strings.begin(), strings.end(), delimiter);
 }
 
+ArenaVector<std::string_view> split(std::string_view data, std::string_view delimiter, Arena* arena) {
+    ArenaVector<std::string_view> strings{ArenaAllocator<std::string_view>{arena}};
+    size_t pos  = 0;
+    size_t prev = 0;
+    while (!delimiter.empty() && (pos = data.find(delimiter, prev)) != std::string_view::npos) {
+        if (pos != prev)// no void items
+            strings.push_back(data.substr(prev, pos - prev));
+        prev = pos + delimiter.size();
+    }
+    strings.push_back(data.substr(prev));
+    return strings;
+}
+
+ArenaString merge(const ArenaVector<std::string_view>& strings, std::string_view delimiter, Arena* arena) {
+    ArenaString result{ArenaAllocator<char>{arena}};
+    size_t length = 0;
+    for (const auto& item : strings)
+        length += item.size() + delimiter.size();
+    result.reserve(length);
+    for (auto it = strings.begin(); it != strings.end(); ++it) {
+        if (it != strings.begin())
+            result.append(delimiter);
+        result.append(*it);
+    }
+    return result;
+}
+
 }// namespace obd::data
@@ -7,7 +7,9 @@
  */
 
 #pragma once
+#include "Arena.h"
 #include "native/OString.h"
+#include <string_view>
 #include <vector>
 
 namespace obd::data {
@@ -54,4 +56,22 @@ OString merge(const std::vector<OString>::const_iterator& from,
 OString merge(const std::vector<OString>& strings,
                   const OString& delimiter);
 
+/**
+ * @brief Split string without copying its components
+ * @param data The string to split
+ * @param delimiter The delimiter used to split
+ * @param arena The arena of the list (nullptr: heap)
+ * @return Views of the string components, valid as long as data
+ */
+ArenaVector<std::string_view> split(std::string_view data, std::string_view delimiter, Arena* arena);
+
+/**
+ * @brief Merge a list of strings in an arena
+ * @param strings The list of string
+ * @param delimiter The delimiter to add between the parts
+ * @param arena The arena of the result (nullptr: heap)
+ * @return The merged string
+ */
+ArenaString merge(const ArenaVector<std::string_view>& strings, std::string_view delimiter, Arena* arena);
+
 }// namespace obd::data
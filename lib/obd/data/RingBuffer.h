@@ -0,0 +1,271 @@
+/**
+ * @file RingBuffer.h
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace obd::data {
+
+/**
+ * @brief What to do when pushing into a full buffer
+ */
+enum struct OverflowPolicy : uint8_t {
+    DropOldest,///< Discard the oldest element to make room for the new one
+    DropNewest,///< Silently discard the new element
+    Reject,    ///< Refuse the new element and report it to the caller
+};
+
+/**
+ * @brief Result of a push in a ring buffer
+ */
+enum struct PushResult : uint8_t {
+    Pushed,       ///< Element stored, nothing lost
+    DroppedOldest,///< Element stored, the oldest one has been discarded
+    DroppedNewest,///< Element discarded, but the caller does not need to know
+    Rejected,     ///< Element refused
+};
+
+/**
+ * @brief FIFO queue over a storage it does not own, without any dynamic allocation
+ * @tparam T Element's type (must be default constructible)
+ *
+ * The storage is given by attach(), its capacity must be a power of two. A
+ * queue without storage refuses everything (or drops it, depending on the
+ * policy).
+ *
+ * With the DropNewest and Reject policies, the queue is lock-free for one
+ * producer and one consumer: the producer only moves the tail, the consumer
+ * only moves the head. With DropOldest, the producer also pops the head: the
+ * queue is then not safe for concurrent use, producer and consumer must run
+ * in the same context (the main loop).
+ *
+ * The counters only increase: the slots are found by masking them, which stays
+ * exact when the counters wrap.
+ */
+template<typename T>
+class RingQueue {
+public:
+    /// Type of the stored elements
+    using value_type = T;
+    /// Type for sizes
+    using size_type = size_t;
+
+    /**
+     * @brief Use a fixed size array as storage
+     * @tparam capacity Number of slots of the array (a power of two)
+     * @param storage The array, it must live as long as the queue
+     */
+    template<size_t capacity>
+    void attach(std::array<T, capacity>& storage) {
+        static_assert(capacity > 0, "RingQueue needs a non null capacity");
+        static_assert((capacity & (capacity - 1)) == 0, "RingQueue capacity must be a power of two");
+        attach(storage.data(), capacity);
+    }
+
+    /**
+     * @brief Use some slots as storage, the queue is emptied
+     * @param storage The first slot, it must live as long as the queue
+     * @param capacity Number of slots (a power of two)
+     */
+    void attach(T* storage, size_type capacity) {
+        buffer = storage;
+        slots  = capacity;
+        mask   = capacity - 1;
+        limit  = capacity;
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_release);
+    }
+
+    /**
+     * @brief Add an element at the end of the queue, depending on the overflow policy
+     * @param value The element to add
+     * @return What happened to the element
+     */
+    PushResult push(const T& value) {
+        return emplace(T{value});
+    }
+
+    /**
+     * @brief Add an element at the end of the queue, depending on the overflow policy
+     * @param value The element to add
+     * @return What happened to the element
+     */
+    PushResult push(T&& value) {
+        return emplace(std::move(value));
+    }
+
+    /**
+     * @brief Get the first element of the queue
+     * @return The first element
+     * @note Undefined if the queue is empty
+     */
+    T& front() { return buffer[head.load(std::memory_order_relaxed) & mask]; }
+
+    /**
+     * @brief Get the first element of the queue
+     * @return The first element
+     * @note Undefined if the queue is empty
+     */
+    const T& front() const { return buffer[head.load(std::memory_order_relaxed) & mask]; }
+
+    /**
+     * @brief Get an element of the queue
+     * @param idx Position from the first element
+     * @return The element
+     * @note Undefined if idx is not lower than size()
+     */
+    const T& operator[](size_type idx) const { return buffer[(head.load(std::memory_order_relaxed) + idx) & mask]; }
+
+    /**
+     * @brief Remove the first element of the queue
+     */
+    void pop() {
+        size_type current = head.load(std::memory_order_relaxed);
+        if (current == tail.load(std::memory_order_acquire))
+            return;
+        // release what the element may hold
+        buffer[current & mask] = T{};
+        head.store(current + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Remove all the elements
+     */
+    void clear() {
+        while (!empty()) pop();
+    }
+
+    /**
+     * @brief Check for emptiness
+     * @return True if empty
+     */
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    /**
+     * @brief Check if the queue reached its limit
+     * @return True if full
+     */
+    [[nodiscard]] bool full() const { return size() >= limit; }
+
+    /**
+     * @brief Get the number of stored elements
+     * @return The number of elements
+     */
+    [[nodiscard]] size_type size() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get the capacity of the storage
+     * @return The capacity
+     */
+    [[nodiscard]] size_type maxSize() const { return slots; }
+
+    /**
+     * @brief Get the effective capacity
+     * @return The effective capacity
+     */
+    [[nodiscard]] size_type getLimit() const { return limit; }
+
+    /**
+     * @brief Reduce the effective capacity of the queue (clamped to the storage capacity)
+     * @param newLimit The new effective capacity
+     */
+    void setLimit(size_type newLimit) {
+        limit = (newLimit == 0 || newLimit > slots) ? slots : newLimit;
+    }
+
+    /**
+     * @brief Get the overflow policy
+     * @return The overflow policy
+     */
+    [[nodiscard]] const OverflowPolicy& getPolicy() const { return policy; }
+
+    /**
+     * @brief Define the overflow policy
+     * @param newPolicy The new overflow policy
+     * @note DropOldest is only safe when producer and consumer run in the same context
+     */
+    void setPolicy(const OverflowPolicy& newPolicy) { policy = newPolicy; }
+
+private:
+    /**
+     * @brief Effective insertion of an element
+     * @param value The element to insert
+     * @return What happened to the element
+     */
+    PushResult emplace(T&& value) {
+        PushResult result = PushResult::Pushed;
+        if (full()) {
+            if (slots == 0)
+                return policy == OverflowPolicy::Reject ? PushResult::Rejected : PushResult::DroppedNewest;
+            switch (policy) {
+            case OverflowPolicy::DropNewest:
+                return PushResult::DroppedNewest;
+            case OverflowPolicy::Reject:
+                return PushResult::Rejected;
+            case OverflowPolicy::DropOldest:
+                pop();
+                result = PushResult::DroppedOldest;
+                break;
+            }
+        }
+        size_type current      = tail.load(std::memory_order_relaxed);
+        buffer[current & mask] = std::move(value);
+        tail.store(current + 1, std::memory_order_release);
+        return result;
+    }
+
+    /// The element storage (not owned)
+    T* buffer = nullptr;
+    /// Number of slots of the storage
+    size_type slots = 0;
+    /// Mask giving the slot of a counter
+    size_type mask = 0;
+    /// Index of the next element to read (monotonic counter)
+    std::atomic<size_type> head{0};
+    /// Index of the next element to write (monotonic counter)
+    std::atomic<size_type> tail{0};
+    /// Effective capacity
+    size_type limit = 0;
+    /// What to do when full
+    OverflowPolicy policy = OverflowPolicy::Reject;
+};
+
+/**
+ * @brief Fixed capacity FIFO queue owning its storage
+ * @tparam T Element's type (must be default constructible)
+ * @tparam capacity Maximum number of elements in the buffer (a power of two)
+ */
+template<typename T, size_t capacity>
+class RingBuffer : public RingQueue<T> {
+public:
+    static_assert(capacity > 0, "RingBuffer needs a non null capacity");
+    static_assert((capacity & (capacity - 1)) == 0, "RingBuffer capacity must be a power of two");
+
+    /**
+     * @brief Empty buffer
+     */
+    RingBuffer() { this->attach(storage); }
+
+    /**
+     * @brief Get the compile-time capacity of the buffer
+     * @return The capacity
+     */
+    [[nodiscard]] static constexpr size_t maxSize() { return capacity; }
+
+private:
+    /// The element storage
+    std::array<T, capacity> storage{};
+};
+
+}// namespace obd::data
@@ -0,0 +1,132 @@
+/**
+ * @file Span.h
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace obd::data {
+
+/**
+ * @brief View over contiguous elements, owned by someone else (std::span is C++20)
+ * @tparam T The element's type, const for a read-only view
+ */
+template<class T>
+class Span {
+public:
+    /// Element's type
+    using element_type = T;
+    /// Iterator type
+    using iterator = T*;
+
+    /**
+     * @brief Empty view
+     */
+    constexpr Span() = default;
+
+    /**
+     * @brief View over a memory area
+     * @param first The first element
+     * @param length The number of elements
+     */
+    constexpr Span(T* first, size_t length) :
+        elements{first}, count{length} {}
+
+    /**
+     * @brief View over an array
+     * @tparam N The array's size
+     * @param array The array
+     */
+    template<size_t N>
+    constexpr Span(T (&array)[N]) :// NOLINT(google-explicit-constructor)
+        elements{array}, count{N} {}
+
+    /**
+     * @brief View over a contiguous container (std::vector, std::array, std::string...)
+     * @tparam Container The container's type
+     * @param container The container
+     */
+    template<class Container, class = std::enable_if_t<std::is_convertible_v<std::remove_pointer_t<decltype(std::declval<Container&>().data())> (*)[], T (*)[]>>>
+    constexpr Span(Container& container) :// NOLINT(google-explicit-constructor)
+        elements{container.data()}, count{container.size()} {}
+
+    /**
+     * @brief Read-only view over a writable one
+     * @tparam U The other view's element type
+     * @param other The other view
+     */
+    template<class U, class = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(const Span<U>& other) :// NOLINT(google-explicit-constructor)
+        elements{other.data()}, count{other.size()} {}
+
+    /**
+     * @brief Get the first element
+     * @return Pointer to the first element
+     */
+    [[nodiscard]] constexpr T* data() const { return elements; }
+
+    /**
+     * @brief Get the number of elements
+     * @return The number of elements
+     */
+    [[nodiscard]] constexpr size_t size() const { return count; }
+
+    /**
+     * @brief Get the size in bytes
+     * @return The size in bytes
+     */
+    [[nodiscard]] constexpr size_t size_bytes() const { return count * sizeof(T); }
+
+    /**
+     * @brief Check for emptiness
+     * @return True if no element
+     */
+    [[nodiscard]] constexpr bool empty() const { return count == 0; }
+
+    /**
+     * @brief Access an element
+     * @param index The element's index (not checked)
+     * @return The element
+     */
+    constexpr T& operator[](size_t index) const { return elements[index]; }
+
+    /**
+     * @brief Get begin iterator
+     * @return Begin iterator
+     */
+    [[nodiscard]] constexpr iterator begin() const { return elements; }
+
+    /**
+     * @brief Get end iterator
+     * @return End iterator
+     */
+    [[nodiscard]] constexpr iterator end() const { return elements + count; }
+
+    /**
+     * @brief Get a part of the view
+     * @param offset The first element of the part
+     * @param length The maximum number of elements of the part
+     * @return The part, clamped to the view
+     */
+    [[nodiscard]] constexpr Span subspan(size_t offset, size_t length = static_cast<size_t>(-1)) const {
+        if (offset > count)
+            offset = count;
+        if (length > count - offset)
+            length = count - offset;
+        return {elements + offset, length};
+    }
+
+private:
+    /// The first element
+    T* elements = nullptr;
+    /// The number of elements
+    size_t count = 0;
+};
+
+}// namespace obd::data
@@ -0,0 +1,53 @@
+/**
+ * @file DirIterator.cpp
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "DirIterator.h"
+
+namespace obd::fs {
+
+#ifndef ARDUINO
+DirIterator::DirIterator(const std::filesystem::path& directory) {
+    std::error_code error;
+    iterator = std::filesystem::directory_iterator(directory, error);
+    opened   = !error;
+}
+#endif
+
+bool DirIterator::next() {
+    if (!opened)
+        return false;
+#ifdef ARDUINO
+#ifdef ESP8266
+    if (!dir.next()) {
+        opened = false;
+        return false;
+    }
+    current.path      = Path(OString(dir.fileName().c_str()));
+    current.directory = dir.isDirectory();
+    current.size      = current.directory ? 0 : dir.fileSize();
+    return true;
+#else
+    return false;
+#endif
+#else
+    std::error_code error;
+    if (started)
+        iterator.increment(error);
+    started = true;
+    if (error || iterator == std::filesystem::directory_iterator()) {
+        opened = false;
+        return false;
+    }
+    current.path      = Path(OString(iterator->path().filename().generic_string()));
+    current.directory = iterator->is_directory(error);
+    current.size      = current.directory ? 0 : static_cast<size_t>(iterator->file_size(error));
+    return true;
+#endif
+}
+
+}// namespace obd::fs
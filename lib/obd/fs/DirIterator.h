@@ -0,0 +1,101 @@
+/**
+ * @file DirIterator.h
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "Path.h"
+#ifdef ARDUINO
+#ifdef ESP8266
+#include <FS.h>
+#endif
+#else
+#include <filesystem>
+#endif
+
+namespace obd::fs {
+
+class FileSystem;
+
+/**
+ * @brief Type and size of a path
+ */
+struct FileStat {
+    bool exists    = false;///< If the path exists
+    bool directory = false;///< If the path is a directory
+    size_t size    = 0;    ///< Size of the file in bytes (0 for a directory)
+};
+
+/**
+ * @brief An entry of a directory
+ */
+struct DirEntry {
+    Path path;             ///< Name of the entry, relative to the directory
+    bool directory = false;///< If the entry is a directory
+    size_t size    = 0;    ///< Size of the file in bytes (0 for a directory)
+};
+
+/**
+ * @brief Lazy listing of a directory: the entries are read one by one, with their type and size
+ *
+ * @code
+ * auto dir = fileSystem->openDir(path);
+ * while (dir.next())
+ *     use(dir.entry());
+ * @endcode
+ */
+class DirIterator {
+public:
+    /**
+     * @brief Iterator over nothing
+     */
+    DirIterator() = default;
+
+    /**
+     * @brief Move to the next entry
+     * @return False when there is no more entry
+     */
+    bool next();
+
+    /**
+     * @brief Get the current entry
+     * @return The entry
+     */
+    [[nodiscard]] const DirEntry& entry() const { return current; }
+
+private:
+    friend class FileSystem;
+    /// The current entry
+    DirEntry current;
+    /// If the directory is opened
+    bool opened = false;
+#ifdef ARDUINO
+#ifdef ESP8266
+    /// The LittleFS directory
+    Dir dir;
+
+    /**
+     * @brief Iterate over a directory
+     * @param directory The opened directory
+     */
+    explicit DirIterator(Dir directory) :
+        opened{true}, dir{std::move(directory)} {}
+#endif
+#else
+    /// The native iterator
+    std::filesystem::directory_iterator iterator;
+    /// If the iterator is on an entry already read
+    bool started = false;
+
+    /**
+     * @brief Iterate over a directory
+     * @param directory The native path of the directory
+     */
+    explicit DirIterator(const std::filesystem::path& directory);
+#endif
+};
+
+}// namespace obd::fs
@@ -8,113 +8,300 @@
 
 #include "File.h"
 #include "data/DataUtils.h"
+#include <algorithm>
+#include <cstring>
 #include <utility>
 #include "FileSystem.h"
 
 namespace obd::fs {
 
-TextFile::TextFile(std::shared_ptr<FileSystem> fileSystem) :
-    _openMode{ios::none},fs{std::move(fileSystem)} {}
+FileHandle::FileHandle(std::shared_ptr<FileSystem> fileSystem) :
+    fs{std::move(fileSystem)} {}
 
-TextFile::~TextFile() {
-    if (isOpened()) {
-        close();
-    }
-}
-TextFile::TextFile(std::shared_ptr<FileSystem> fileSystem, const Path& path, const ios& openMode) :
-    _openMode{ios::none},fs{std::move(fileSystem)} {
-    open(path, openMode);
+FileHandle::~FileHandle() {
+    close();
 }
 
-bool TextFile::open([[maybe_unused]]const Path& path, [[maybe_unused]]const ios& openMode) {
-    if (_openMode != ios::none)
+bool FileHandle::open([[maybe_unused]] const Path& path, const ios& openMode) {
+    if (_openMode != ios::none || fs == nullptr || openMode == ios::none)
         return false;
 #ifdef ARDUINO
-    return false;
-#else
+#ifdef ESP8266
+    Path absolutePath = path;
+    absolutePath.makeAbsolute(fs->cwd());
+    const char* fileMode = openMode == ios::in ? "r" : (openMode == ios::app ? "a" : "w");
+    file                 = LittleFS.open(absolutePath.toString().c_str(), fileMode);
+    if (!file)
+        return false;
     _openMode = openMode;
-    if (_openMode == ios::in) {
-        fileStream.open(fs->toStdPath(path), std::ios::in);
-    } else if (_openMode == ios::app) {
-        fileStream.open(fs->toStdPath(path), std::ios::out | std::ios::app);
-    } else if (_openMode == ios::out) {
-        fileStream.open(fs->toStdPath(path), std::ios::out);
+#endif
+#else
+    if (openMode == ios::in) {
+        fileStream.open(fs->toStdPath(path), std::ios::in | std::ios::binary);
+    } else if (openMode == ios::app) {
+        fileStream.open(fs->toStdPath(path), std::ios::out | std::ios::app | std::ios::binary);
     } else {
-        _openMode = ios::none;
+        fileStream.open(fs->toStdPath(path), std::ios::out | std::ios::binary);
     }
     if (!fileStream.is_open())
-        _openMode = ios::none;
-    return _openMode != ios::none;
+        return false;
+    _openMode = openMode;
 #endif
+    if (writable())
+        fs->invalidateStats();
+    return _openMode != ios::none;
 }
 
-void TextFile::close() {
+void FileHandle::close() {
     if (_openMode == ios::none)
         return;
-    _openMode = ios::none;
+    bool written = writable();
+    _openMode    = ios::none;
 #ifdef ARDUINO
+#ifdef ESP8266
+    file.close();
+#endif
 #else
     fileStream.close();
 #endif
+    // the size is final once closed
+    if (written)
+        fs->invalidateStats();
 }
-bool TextFile::isOpened() const { return _openMode != ios::none; }
 
-char TextFile::read() {
-    if (_openMode != ios::in)
+size_t FileHandle::read([[maybe_unused]] char* data, [[maybe_unused]] size_t size) {
+    if (!readable())
         return 0;
 #ifdef ARDUINO
+#ifdef ESP8266
+    return file.read(reinterpret_cast<uint8_t*>(data), size);
+#else
     return 0;
+#endif
 #else
-    char readChar=0;
-    fileStream.read(&readChar, 1);
-    return readChar;
+    fileStream.read(data, static_cast<std::streamsize>(size));
+    return static_cast<size_t>(fileStream.gcount());
 #endif
 }
 
-OString TextFile::readLine([[maybe_unused]]size_t max_size,[[maybe_unused]] bool keepEndLines) {
-    if (_openMode != ios::in)
-        return {};
-    OString result;
+size_t FileHandle::write([[maybe_unused]] const char* data, [[maybe_unused]] size_t size) {
+    if (!writable())
+        return 0;
 #ifdef ARDUINO
-
+#ifdef ESP8266
+    return file.write(reinterpret_cast<const uint8_t*>(data), size);
 #else
-    size_t count = 0;
-    do {
-        char readChar = read();
-        if (!keepEndLines && (readChar == '\n' || readChar == '\r'))
-            break;
-        result.push_back(readChar);
-        ++count;
-    } while (fileStream && result.back() != '\n' && count < max_size);
+    return 0;
+#endif
+#else
+    fileStream.write(data, static_cast<std::streamsize>(size));
+    return fileStream ? size : 0;
 #endif
-    return result;
 }
 
-void TextFile::write([[maybe_unused]] const char data) {
-    if (_openMode != ios::out && _openMode != ios::app)
-        return;
+bool FileHandle::seek([[maybe_unused]] size_t position) {
+    if (_openMode == ios::none)
+        return false;
 #ifdef ARDUINO
-
+#ifdef ESP8266
+    return file.seek(position, ::fs::SeekSet);
+#else
+    return false;
+#endif
 #else
-    fileStream.put(data);
+    // leave the end of file state of a previous read
+    fileStream.clear();
+    if (readable())
+        fileStream.seekg(static_cast<std::streamoff>(position));
+    else
+        fileStream.seekp(static_cast<std::streamoff>(position));
+    return !fileStream.fail();
 #endif
 }
-void TextFile::write([[maybe_unused]]const OString& data) {
-    if (_openMode != ios::out && _openMode != ios::app)
-        return;
+
+size_t FileHandle::tell() {
+    if (_openMode == ios::none)
+        return 0;
 #ifdef ARDUINO
+#ifdef ESP8266
+    return file.position();
+#else
+    return 0;
+#endif
+#else
+    fileStream.clear(fileStream.rdstate() & ~std::ios::failbit & ~std::ios::eofbit);
+    auto position = readable() ? fileStream.tellg() : fileStream.tellp();
+    return position < 0 ? 0 : static_cast<size_t>(position);
+#endif
+}
 
+size_t FileHandle::size() {
+    if (_openMode == ios::none)
+        return 0;
+#ifdef ARDUINO
+#ifdef ESP8266
+    return file.size();
 #else
-    for (auto writeChar : data)
-        fileStream.put(writeChar);
+    return 0;
+#endif
+#else
+    size_t position = tell();
+    if (readable())
+        fileStream.seekg(0, std::ios::end);
+    else
+        fileStream.seekp(0, std::ios::end);
+    size_t result = tell();
+    seek(position);
+    return result;
 #endif
 }
-bool TextFile::available() const {
+
+void FileHandle::flush() {
+    if (!writable())
+        return;
 #ifdef ARDUINO
-    return false;
+#ifdef ESP8266
+    file.flush();
+#endif
 #else
-    return !fileStream.eof();
+    fileStream.flush();
 #endif
 }
 
+TextFile::TextFile(std::shared_ptr<FileSystem> fileSystem) :
+    handle{std::move(fileSystem)} {}
+
+TextFile::~TextFile() {
+    if (isOpened()) {
+        close();
+    }
+}
+TextFile::TextFile(std::shared_ptr<FileSystem> fileSystem, const Path& path, const ios& openMode) :
+    handle{std::move(fileSystem)} {
+    open(path, openMode);
+}
+
+bool TextFile::setBuffer(char* data, size_t size) {
+    if (isOpened() || data == nullptr || size == 0)
+        return false;
+    buffer     = data;
+    bufferSize = size;
+    return true;
+}
+
+bool TextFile::open(const Path& path, const ios& openMode) {
+    if (isOpened())
+        return false;
+    bufferPos = 0;
+    bufferEnd = 0;
+    return handle.open(path, openMode);
+}
+
+void TextFile::close() {
+    if (!isOpened())
+        return;
+    flush();
+    handle.close();
+}
+bool TextFile::isOpened() const { return handle.mode() != ios::none; }
+
+char TextFile::read() {
+    if (!handle.readable())
+        return 0;
+    if (bufferPos == bufferEnd && !fill())
+        return 0;
+    return buffer[bufferPos++];
+}
+
+OString TextFile::readLine(size_t max_size, bool keepEndLines) {
+    if (!handle.readable())
+        return {};
+    OString result;
+    while (result.size() < max_size) {
+        if (bufferPos == bufferEnd && !fill())
+            break;
+        const char* start = buffer + bufferPos;
+        size_t count      = std::min(bufferEnd - bufferPos, max_size - result.size());
+        const auto* found = static_cast<const char*>(std::memchr(start, '\n', count));
+        size_t length     = found == nullptr ? count : static_cast<size_t>(found - start) + 1;
+        result.append(start, length);
+        bufferPos += length;
+        if (found != nullptr)
+            break;
+    }
+    if (!keepEndLines) {
+        while (!result.empty() && (result.back() == '\n' || result.back() == '\r'))
+            result.pop_back();
+    }
+    return result;
+}
+
+void TextFile::write(const char data) {
+    if (!handle.writable())
+        return;
+    if (bufferPos == bufferSize)
+        drain();
+    buffer[bufferPos++] = data;
+}
+
+void TextFile::write(const OString& data) {
+    if (!handle.writable())
+        return;
+    size_t done = 0;
+    while (done < data.size()) {
+        if (bufferPos == 0 && data.size() - done >= bufferSize) {
+            // bigger than the buffer: no copy
+            handle.write(data.data() + done, data.size() - done);
+            return;
+        }
+        size_t count = std::min(bufferSize - bufferPos, data.size() - done);
+        std::memcpy(buffer + bufferPos, data.data() + done, count);
+        bufferPos += count;
+        done += count;
+        if (bufferPos == bufferSize)
+            drain();
+    }
+}
+
+void TextFile::flush() {
+    if (!handle.writable())
+        return;
+    drain();
+    handle.flush();
+}
+
+bool TextFile::available() {
+    if (!handle.readable())
+        return false;
+    return bufferPos < bufferEnd || fill();
+}
+
+void TextFile::drain() {
+    if (bufferPos > 0)
+        handle.write(buffer, bufferPos);
+    bufferPos = 0;
+}
+
+bool TextFile::fill() {
+    bufferPos = 0;
+    bufferEnd = handle.read(buffer, bufferSize);
+    return bufferEnd > 0;
+}
+
+BinaryFile::BinaryFile(std::shared_ptr<FileSystem> fileSystem) :
+    handle{std::move(fileSystem)} {}
+
+BinaryFile::BinaryFile(std::shared_ptr<FileSystem> fileSystem, const Path& path, const ios& openMode) :
+    handle{std::move(fileSystem)} {
+    open(path, openMode);
+}
+
+size_t BinaryFile::read(data::Span<uint8_t> data) {
+    return handle.read(reinterpret_cast<char*>(data.data()), data.size());
+}
+
+size_t BinaryFile::write(data::Span<const uint8_t> data) {
+    return handle.write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
 }// namespace obd::fs
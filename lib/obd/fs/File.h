@@ -8,6 +8,10 @@
 
 #pragma once
 #include "Path.h"
+#include "config.h"
+#include "data/Span.h"
+#include <array>
+#include <cstdint>
 #ifdef ARDUINO
 #ifdef ESP8266
 #include <FS.h>
@@ -29,8 +33,126 @@ enum struct ios { none,
                   out,
                   app };
 
+/**
+ * @brief Unbuffered access to a file of the file system, LittleFS on device, std::fstream on native
+ */
+class FileHandle {
+public:
+    /**
+     * @brief Constructor
+     * @param fileSystem Link to the filesystem
+     */
+    explicit FileHandle(std::shared_ptr<FileSystem> fileSystem);
+    FileHandle(const FileHandle&) = delete;
+    FileHandle(FileHandle&&)      = delete;
+    FileHandle& operator=(const FileHandle&) = delete;
+    FileHandle& operator=(FileHandle&&) = delete;
+
+    /**
+     * @brief Destructor, close the file
+     */
+    ~FileHandle();
+
+    /**
+     * @brief Open the file
+     * @param path The path to the file, relative to the working directory
+     * @param openMode The open mode of the file
+     * @return True if open succeed
+     */
+    bool open(const Path& path, const ios& openMode);
+
+    /**
+     * @brief Close the file
+     */
+    void close();
+
+    /**
+     * @brief Get the open mode
+     * @return The open mode, none if closed
+     */
+    [[nodiscard]] const ios& mode() const { return _openMode; }
+
+    /**
+     * @brief Check for the reading mode
+     * @return True if opened for reading
+     */
+    [[nodiscard]] bool readable() const { return _openMode == ios::in; }
+
+    /**
+     * @brief Check for the writing modes
+     * @return True if opened for writing
+     */
+    [[nodiscard]] bool writable() const { return _openMode == ios::out || _openMode == ios::app; }
+
+    /**
+     * @brief Read a block
+     * @param data Where to store the data
+     * @param size The maximum amount of data
+     * @return The amount of data read
+     */
+    size_t read(char* data, size_t size);
+
+    /**
+     * @brief Write a block
+     * @param data The data
+     * @param size The amount of data
+     * @return The amount of data written
+     */
+    size_t write(const char* data, size_t size);
+
+    /**
+     * @brief Move to a position
+     * @param position The position from the file's beginning
+     * @return False if not possible
+     */
+    bool seek(size_t position);
+
+    /**
+     * @brief Get the position
+     * @return The position from the file's beginning
+     */
+    [[nodiscard]] size_t tell();
+
+    /**
+     * @brief Get the size of the file
+     * @return The size in bytes
+     */
+    [[nodiscard]] size_t size();
+
+    /**
+     * @brief Push the written data to the file system
+     */
+    void flush();
+
+    /**
+     * @brief Get the file system
+     * @return The file system
+     */
+    [[nodiscard]] const std::shared_ptr<FileSystem>& fileSystem() const { return fs; }
+
+private:
+    /// The OpenMode of the file
+    ios _openMode = ios::none;
+
+    /// Pointer to the file System
+    std::shared_ptr<FileSystem> fs;
+#ifdef ARDUINO
+#ifdef ESP8266
+    /// The LittleFS file
+    ::fs::File file;
+#endif
+#else
+    /// The native file
+    std::fstream fileStream;
+#endif
+};
+
 /**
  * @brief Class handling file
+ *
+ * The reads and writes go through a buffer, filled or emptied one block at a time.
+ * The written data reach the file on flush(), close() or when the buffer is full;
+ * only flush() and close() sync the file system.
  */
 class TextFile {
 public:
@@ -52,6 +174,14 @@ public:
      */
     TextFile(std::shared_ptr<FileSystem> fileSystem, const Path& path, const ios& openMode = ios::in);
 
+    /**
+     * @brief Use a buffer of the user instead of the file's own one
+     * @param data The buffer, must live until the file is closed
+     * @param size The size of the buffer (256 to 512 bytes is a good block size)
+     * @return False if the file is opened or the buffer is empty
+     */
+    bool setBuffer(char* data, size_t size);
+
     /**
      * @brief Open the file
      * @param path The path to the file
@@ -61,7 +191,7 @@ public:
     bool open(const Path& path, const ios& openMode);
 
     /**
-     * @brief Close and release the file
+     * @brief Close and release the file, after writing the buffered data
      */
     void close();
 
@@ -73,7 +203,7 @@ public:
 
     /**
      * @brief Read one char of the file
-     * @return The read char
+     * @return The read char, 0 at the end of the file
      */
     [[nodiscard]] char read();
 
@@ -81,7 +211,7 @@ public:
      * @brief Something available for reading?
      * @return True if not at EOF
      */
-    bool available()const;
+    bool available();
 
     /**
      * @brief Read a whole line to the file
@@ -103,18 +233,116 @@ public:
      */
     void write(const OString& data);
 
+    /**
+     * @brief Write the buffered data to the file
+     */
+    void flush();
+
 private:
-    /// The OpenMode of the file
-    ios _openMode;
+    /// The file
+    FileHandle handle;
+    /// The file's own buffer
+    std::array<char, config::fileBufferSize> ownBuffer{};
+    /// The buffer in use
+    char* buffer = ownBuffer.data();
+    /// Size of the buffer in use
+    size_t bufferSize = ownBuffer.size();
+    /// Reading: next char to read, writing: amount of data waiting
+    size_t bufferPos = 0;
+    /// Reading: end of the read data
+    size_t bufferEnd = 0;
 
-    /// Pointer to the file System
-    std::shared_ptr<FileSystem> fs;
-#ifdef ARDUINO
-#ifdef ESP8266
-#endif
-#else
-    std::fstream fileStream;
-#endif
+    /**
+     * @brief Read the next block of the file in the buffer
+     * @return False at the end of the file
+     */
+    bool fill();
+
+    /**
+     * @brief Hand the buffered data to the file, without syncing it to the storage
+     */
+    void drain();
+};
+
+/**
+ * @brief Class handling binary file, read and written by blocks without buffering
+ */
+class BinaryFile {
+public:
+    /**
+     * @brief Default Constructor
+     * @param fileSystem link to the filesystem
+     */
+    explicit BinaryFile(std::shared_ptr<FileSystem> fileSystem);
+
+    /**
+     * @brief Constructor that open the file
+     * @param fileSystem Link to the filesystem
+     * @param path The path of the file
+     * @param openMode The open mode of the file.
+     */
+    BinaryFile(std::shared_ptr<FileSystem> fileSystem, const Path& path, const ios& openMode = ios::in);
+
+    /**
+     * @brief Open the file
+     * @param path The path to the file
+     * @param openMode The open mode of the file
+     * @return True if open succeed
+     */
+    bool open(const Path& path, const ios& openMode) { return handle.open(path, openMode); }
+
+    /**
+     * @brief Close and release the file
+     */
+    void close() { handle.close(); }
+
+    /**
+     * @brief Check whether the file is opened
+     * @return True if opened
+     */
+    [[nodiscard]] bool isOpened() const { return handle.mode() != ios::none; }
+
+    /**
+     * @brief Read data from the current position
+     * @param data Where to store the data, its size is the amount to read
+     * @return The amount of bytes read, less at the end of the file
+     */
+    size_t read(data::Span<uint8_t> data);
+
+    /**
+     * @brief Write data at the current position
+     * @param data The data to write
+     * @return The amount of bytes written
+     */
+    size_t write(data::Span<const uint8_t> data);
+
+    /**
+     * @brief Move to a position
+     * @param position The position from the file's beginning
+     * @return False if not possible
+     */
+    bool seek(size_t position) { return handle.seek(position); }
+
+    /**
+     * @brief Get the current position
+     * @return The position from the file's beginning
+     */
+    [[nodiscard]] size_t tell() { return handle.tell(); }
+
+    /**
+     * @brief Get the size of the file
+     * @return The size in bytes
+     */
+    [[nodiscard]] size_t size() { return handle.size(); }
+
+    /**
+     * @brief Push the written data to the file system
+     */
+    void flush() { handle.flush(); }
+
+private:
+    /// The file
+    FileHandle handle;
 };
 
 }// namespace obd::fs
@@ -13,9 +13,22 @@
 #include <LittleFS.h>
 #endif
 #include "time/Clock.h"
+#ifndef ARDUINO
+#include <fstream>
+#endif
 
 namespace obd::fs {
 
+namespace {
+/**
+ * @brief Forget the remembered stats when leaving the scope of a change
+ */
+struct StatInvalidator {
+    const FileSystem& fileSystem;///< The changed filesystem
+    ~StatInvalidator() { fileSystem.invalidateStats(); }
+};
+}// namespace
+
 void FileSystem::init() {
     Node::init();
     if (!initialized())
@@ -51,46 +64,69 @@ void FileSystem::terminate() {
 #endif
 }
 
-bool FileSystem::exists(const Path& path) const {
+FileStat FileSystem::stat(const Path& path) const {
     if (!initialized())
-        return false;
+        return {};
+    Path absolutePath = path;
+    absolutePath.makeAbsolute(currentWorkingDir);
+    ++statCacheClock;
+    CachedStat* oldest = &statCache.front();
+    for (auto& cached : statCache) {
+        if (cached.lastUse != 0 && cached.path == absolutePath.toString()) {
+            cached.lastUse = statCacheClock;
+            ++statCacheHits;
+            return cached.stat;
+        }
+        if (cached.lastUse < oldest->lastUse)
+            oldest = &cached;
+    }
+    ++statCacheMisses;
+    oldest->path    = absolutePath.toString();
+    oldest->stat    = readStat(absolutePath);
+    oldest->lastUse = statCacheClock;
+    return oldest->stat;
+}
+
+FileStat FileSystem::readStat([[maybe_unused]] const Path& path) const {
+    FileStat result;
 #ifdef ARDUINO
 #ifdef ESP8266
-    return LittleFS.exists(path.name().c_str());
+    // a single open gives existence, type and size
+    auto file = LittleFS.open(path.toString().c_str(), "r");
+    if (!file)
+        return result;
+    result.exists    = true;
+    result.directory = file.isDirectory();
+    result.size      = result.directory ? 0 : file.size();
 #endif
 #else
-    return std::filesystem::exists(toStdPath(path));
+    std::error_code error;
+    auto status      = std::filesystem::status(toStdPath(path), error);
+    result.exists    = std::filesystem::exists(status);
+    result.directory = std::filesystem::is_directory(status);
+    if (std::filesystem::is_regular_file(status))
+        result.size = static_cast<size_t>(std::filesystem::file_size(toStdPath(path), error));
 #endif
+    return result;
 }
 
-bool FileSystem::isDir(const Path& path) const {
-    if (!initialized())
-        return false;
-#ifdef ARDUINO
-#ifdef ESP8266
-    if (!LittleFS.exists(path.toString().c_str())) {
-        return false;
+void FileSystem::invalidateStats() const {
+    for (auto& cached : statCache) {
+        cached.lastUse = 0;
     }
-    return LittleFS.open(path.toString().c_str(), "r").isDirectory();
-#endif
-#else
-    return std::filesystem::is_directory(toStdPath(path));
-#endif
+}
+
+bool FileSystem::exists(const Path& path) const {
+    return stat(path).exists;
+}
+
+bool FileSystem::isDir(const Path& path) const {
+    return stat(path).directory;
 }
 
 bool FileSystem::isFile(const Path& path) const {
-    if (!initialized())
-        return false;
-#ifdef ARDUINO
-#ifdef ESP8266
-    if (!LittleFS.exists(path.toString().c_str())) {
-        return false;
-    }
-    return LittleFS.open(path.toString().c_str(), "r").isFile();
-#endif
-#else
-    return std::filesystem::is_regular_file(toStdPath(path));
-#endif
+    auto fileStat = stat(path);
+    return fileStat.exists && !fileStat.directory;
 }
 
 bool FileSystem::mkdir(const Path& path, bool parents, bool existsOk) {
@@ -103,6 +139,7 @@ bool FileSystem::mkdir(const Path& path, bool parents, bool existsOk) {
     if (exists(path)) {
         return existsOk;
     }
+    StatInvalidator invalidator{*this};
     Path dir(path);
     if (!dir.isAbsolute()) {
         dir.makeAbsolute(currentWorkingDir);
@@ -154,6 +191,7 @@ bool FileSystem::rmdir(const Path& path, bool recursive, bool notExistsOk) {
     if (!isDir(path)) {
         return notExistsOk;
     }
+    StatInvalidator invalidator{*this};
     Path dir(path);
     if (!dir.isAbsolute()) {
         dir.makeAbsolute(currentWorkingDir);
@@ -191,6 +229,15 @@ bool FileSystem::rmdir(const Path& path, bool recursive, bool notExistsOk) {
 }
 
 std::vector<Path> FileSystem::listDir(const Path& path) const {
+    std::vector<Path> listFiles;
+    auto dir = openDir(path);
+    while (dir.next()) {
+        listFiles.push_back(dir.entry().path);
+    }
+    return listFiles;
+}
+
+DirIterator FileSystem::openDir(const Path& path) const {
     Path work{path};
     if (path.toString().empty()) {
         work = currentWorkingDir;
@@ -198,23 +245,16 @@ std::vector<Path> FileSystem::listDir(const Path& path) const {
     if (!initialized() || !isDir(work)) {
         return {};
     }
-    std::vector<Path> listFiles;
 #ifdef ARDUINO
 #ifdef ESP8266
-    Dir dir = LittleFS.openDir(work.toString().c_str());
-    while (dir.next()) {
-        OString name(dir.fileName().c_str());
-        listFiles.emplace_back(name.c_str());
-    }
+    work.makeAbsolute(currentWorkingDir);
+    return DirIterator(LittleFS.openDir(work.toString().c_str()));
+#else
+    return {};
 #endif
 #else
-    auto stdPath = toStdPath(work);
-    for (const auto& directoryEntry : std::filesystem::directory_iterator(stdPath)) {
-        listFiles.push_back(Path(toInternalPath(directoryEntry.path())));
-        listFiles.back().makeRelative(work);
-    }
+    return DirIterator(toStdPath(work));
 #endif
-    return listFiles;
 }
 
 bool FileSystem::rm(const Path& path) const {
@@ -224,6 +264,7 @@ bool FileSystem::rm(const Path& path) const {
     if (!isFile(path)) {
         return false;
     }
+    StatInvalidator invalidator{*this};
     Path dir(path);
     if (!dir.isAbsolute()) {
         dir.makeAbsolute(currentWorkingDir);
@@ -275,19 +316,56 @@ bool FileSystem::touch(const Path& path) {
     if (!isDir(absolutePath.parent())) {
         return false;
     }
-    TextFile touchedFile(shared_from_this(), absolutePath, ios::out);
-    touchedFile.close();
+    StatInvalidator invalidator{*this};
+    // created directly: a node does not own a pointer to itself
+#ifdef ARDUINO
+#ifdef ESP8266
+    auto file = LittleFS.open(absolutePath.toString().c_str(), "w");
+    if (!file)
+        return false;
+    file.close();
+#endif
     return true;
+#else
+    std::ofstream file{toStdPath(absolutePath), std::ios::out | std::ios::binary};
+    return file.is_open();
+#endif
+}
+
+
+core::driver::CommandTable FileSystem::commands() const {
+    static constexpr core::driver::CommandEntry table[] = {
+            {Commands::Ls, "ls", 0, core::driver::commandHandler<&FileSystem::cmdLs>(), "[<path>] List a directory with the size of the files", {}},
+    };
+    static_assert(core::driver::CommandTable::sorted(table), "commands must be sorted by id");
+    return table;
 }
 
+void FileSystem::cmdLs(const Message& message) {
+    auto words = message.getWords(1);
+    auto dir   = openDir(words.empty() ? Path("") : Path(OString{words[0]}));
+    // plain message: printed by the consoles
+    Message msg{id(), message.getSource(), MessageType::Message};
+    while (dir.next()) {
+        const auto& entry = dir.entry();
+        msg.print(entry.path.toString());
+        if (entry.directory) {
+            msg.println("/");
+            continue;
+        }
+        msg.print(" ");
+        msg.println(static_cast<uint64_t>(entry.size));
+    }
+    broadcastMessage(msg);
+}
 
-OString FileSystem::info() const {
+core::driver::Message::DataType FileSystem::info() const {
     OString result;
     result = F(" ----- FILESYSTEM INFORMATION -----\n");
     result += OString("cwd: ") + currentWorkingDir.toString() + OString("\n");
     result += OString((initialized()) ? "" : "not ") + OString("initialized\n");
 #ifndef ARDUINO
-    result += "Native base path: " + basePath + OString("\n");
+    result += "Native base path: " + basePath.string() + OString("\n");
 #endif
     if (!initialized())
         return {};
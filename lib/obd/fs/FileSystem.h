@@ -7,8 +7,10 @@
  */
 
 #pragma once
+#include "DirIterator.h"
 #include "File.h"
 #include "core/driver/Node.h"
+#include <array>
 #include <utility>
 #include <vector>
 
@@ -24,14 +26,21 @@ namespace obd::fs {
 /**
  * @brief Class to handle interaction with file system
  */
-class FileSystem : public core::driver::Node, public std::enable_shared_from_this<FileSystem> {
+class FileSystem : public core::driver::Node {
 public:
+    /**
+     * @brief Ids of the file system's own commands
+     */
+    struct Commands {
+        static constexpr CommandId Ls = core::driver::nodeCommand(0);///< List a directory
+    };
+
     /**
      * @brief Constructor with parent
      * @param parent The parent system
      */
     explicit FileSystem(std::shared_ptr<Messenger> parent) :
-        Node(std::move(parent)), currentWorkingDir(Path("/")) {}
+        Node(std::move(parent), queueStorage), currentWorkingDir(Path("/")) {}
 
     /**
    * @brief Initialize file system
@@ -43,6 +52,30 @@ public:
    */
     void terminate() override;
 
+    /**
+     * @brief Get the type and size of a path, remembered until the next change made through the filesystem
+     * @param path The path to check
+     * @return The information about the path (nothing exists if not initialized)
+     */
+    [[nodiscard]] FileStat stat(const Path& path) const;
+
+    /**
+     * @brief Forget the remembered information about paths
+     */
+    void invalidateStats() const;
+
+    /**
+     * @brief Get the number of stat requests answered without asking the storage
+     * @return The number of cache hits
+     */
+    [[nodiscard]] size_t statHits() const { return statCacheHits; }
+
+    /**
+     * @brief Get the number of stat requests that asked the storage
+     * @return The number of cache misses
+     */
+    [[nodiscard]] size_t statMisses() const { return statCacheMisses; }
+
     /**
    * @brief Check if the path exist (either file or dir)
    * @param path The path to check.
@@ -107,6 +140,13 @@ public:
    */
     [[nodiscard]] std::vector<Path> listDir(const Path& path = Path("")) const;
 
+    /**
+     * @brief Open a directory to read its entries one by one
+     * @param path The directory to list (default: current working directory)
+     * @return The iterator over the entries (empty if not a directory)
+     */
+    [[nodiscard]] DirIterator openDir(const Path& path = Path("")) const;
+
     /**
    * @brief Get the current working directory
    * @return The current working directory
@@ -142,6 +182,9 @@ public:
     bool linkNode(const std::shared_ptr<Node>& node) override;
 
 private:
+    /// Storage of the message queue
+    QueueStorage<config::fileSystemQueueLength> queueStorage;
+
     /// Current working directory
     Path currentWorkingDir;
     /// lin to the clock
@@ -150,12 +193,47 @@ private:
     /// Base path for native OS
     std::filesystem::path basePath;
 #endif
+    /**
+     * @brief Remembered information about a path
+     */
+    struct CachedStat {
+        OString path;     ///< The absolute path
+        FileStat stat;    ///< The information
+        size_t lastUse = 0;///< Date of the last use (0 for a free entry)
+    };
+    /// The most recently used paths
+    mutable std::array<CachedStat, config::statCacheLength> statCache;
+    /// Counter giving the dates of use of the cache
+    mutable size_t statCacheClock = 0;
+    /// Number of requests answered by the cache
+    mutable size_t statCacheHits = 0;
+    /// Number of requests that asked the storage
+    mutable size_t statCacheMisses = 0;
+
+    /**
+     * @brief Ask the storage the type and size of a path
+     * @param path The absolute path
+     * @return The information
+     */
+    [[nodiscard]] FileStat readStat(const Path& path) const;
 
     /**
      * @brief Get information about file system
      * @return String of information
      */
-    [[nodiscard]] OString info() const override;
+    [[nodiscard]] Message::DataType info() const override;
+
+    /**
+     * @brief Get the filesystem commands
+     * @return The command table
+     */
+    [[nodiscard]] core::driver::CommandTable commands() const override;
+
+    /**
+     * @brief Command 'ls': reply the entries of a directory with their type and size
+     * @param message The command
+     */
+    void cmdLs(const Message& message);
 
     /**
      * @brief Set time callback
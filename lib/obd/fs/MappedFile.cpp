@@ -0,0 +1,101 @@
+/**
+ * @file MappedFile.cpp
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#include "MappedFile.h"
+#include "FileSystem.h"
+#include <algorithm>
+#include <utility>
+#ifdef OBD_MAPPED_FILES
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace obd::fs {
+
+#ifdef OBD_MAPPED_FILES
+MappedFile::MappedFile(std::shared_ptr<FileSystem> fileSystem) :
+    fs{std::move(fileSystem)} {}
+#else
+MappedFile::MappedFile(std::shared_ptr<FileSystem> fileSystem) :
+    fs{fileSystem}, file{std::move(fileSystem)} {}
+#endif
+
+MappedFile::MappedFile(std::shared_ptr<FileSystem> fileSystem, const Path& path) :
+    MappedFile(std::move(fileSystem)) {
+    open(path);
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const Path& path) {
+    if (opened || fs == nullptr)
+        return false;
+#ifdef OBD_MAPPED_FILES
+    int descriptor = ::open(fs->toStdPath(path).c_str(), O_RDONLY);
+    if (descriptor < 0)
+        return false;
+    struct stat status {};
+    if (fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode)) {
+        ::close(descriptor);
+        return false;
+    }
+    fileSize = static_cast<size_t>(status.st_size);
+    // an empty file cannot be mapped, and does not need to
+    if (fileSize > 0) {
+        void* address = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (address == MAP_FAILED) {
+            ::close(descriptor);
+            fileSize = 0;
+            return false;
+        }
+        mapping = static_cast<const uint8_t*>(address);
+    }
+    // the mapping keeps the file
+    ::close(descriptor);
+#else
+    if (!file.open(path, ios::in))
+        return false;
+    fileSize = file.size();
+#endif
+    opened = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (!opened)
+        return;
+#ifdef OBD_MAPPED_FILES
+    if (mapping != nullptr)
+        munmap(const_cast<uint8_t*>(mapping), fileSize);
+    mapping = nullptr;
+#else
+    file.close();
+#endif
+    fileSize = 0;
+    opened   = false;
+}
+
+data::Span<const uint8_t> MappedFile::view(size_t offset, size_t length) {
+    if (!opened || offset >= fileSize)
+        return {};
+    length = std::min(length, fileSize - offset);
+#ifdef OBD_MAPPED_FILES
+    return {mapping + offset, length};
+#else
+    length = std::min(length, window.size());
+    if (!file.seek(offset))
+        return {};
+    return {window.data(), file.read({window.data(), length})};
+#endif
+}
+
+}// namespace obd::fs
@@ -0,0 +1,102 @@
+/**
+ * @file MappedFile.h
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+
+#pragma once
+#include "File.h"
+#include <array>
+#include <cstdint>
+
+#if !defined(ARDUINO) && !defined(_WIN32)
+/// The native files are mapped in memory
+#define OBD_MAPPED_FILES
+#endif
+
+namespace obd::fs {
+
+/**
+ * @brief Read-only access to a whole file, without copy when the platform maps files
+ *
+ * On native (POSIX) builds the file is mapped in memory: a view is a window over
+ * the mapping, valid until close. On device the views are read in the file's
+ * buffer, at most config::fileBufferSize bytes, valid until the next view.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Default Constructor
+     * @param fileSystem link to the filesystem
+     */
+    explicit MappedFile(std::shared_ptr<FileSystem> fileSystem);
+
+    /**
+     * @brief Constructor that open the file
+     * @param fileSystem Link to the filesystem
+     * @param path The path of the file
+     */
+    MappedFile(std::shared_ptr<FileSystem> fileSystem, const Path& path);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&)      = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    /**
+     * @brief Destructor, release the file
+     */
+    ~MappedFile();
+
+    /**
+     * @brief Open the file
+     * @param path The path to the file
+     * @return True if open succeed
+     */
+    bool open(const Path& path);
+
+    /**
+     * @brief Release the file, the views are no longer valid
+     */
+    void close();
+
+    /**
+     * @brief Check whether the file is opened
+     * @return True if opened
+     */
+    [[nodiscard]] bool isOpened() const { return opened; }
+
+    /**
+     * @brief Get the size of the file
+     * @return The size in bytes
+     */
+    [[nodiscard]] size_t size() const { return fileSize; }
+
+    /**
+     * @brief Get a part of the file
+     * @param offset The position of the part in the file
+     * @param length The maximum length of the part
+     * @return The part, shorter at the end of the file (or on device, than the buffer)
+     */
+    [[nodiscard]] data::Span<const uint8_t> view(size_t offset = 0, size_t length = static_cast<size_t>(-1));
+
+private:
+    /// Pointer to the file System
+    std::shared_ptr<FileSystem> fs;
+    /// If the file is opened
+    bool opened = false;
+    /// Size of the file
+    size_t fileSize = 0;
+#ifdef OBD_MAPPED_FILES
+    /// The file's content in memory
+    const uint8_t* mapping = nullptr;
+#else
+    /// The file
+    BinaryFile file;
+    /// The last view
+    std::array<uint8_t, config::fileBufferSize> window{};
+#endif
+};
+
+}// namespace obd::fs
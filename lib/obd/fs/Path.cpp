@@ -6,10 +6,84 @@
  * All modification must get authorization from the author.
  */
 #include "Path.h"
-#include "data/DataUtils.h"
+#include <algorithm>
+#include <cstring>
 
 namespace obd::fs {
 
+namespace {
+
+/**
+ * @brief Read-only view over a string's chars
+ * @param str The string
+ * @return The view
+ */
+std::string_view view(const OString& str) {
+    return {str.c_str(), static_cast<size_t>(str.length())};
+}
+
+/**
+ * @brief Writable access to a string's chars
+ * @param str The string
+ * @return The first char
+ */
+char* buffer(OString& str) {
+#ifdef ARDUINO
+    return str.begin();
+#else
+    return str.data();
+#endif
+}
+
+/**
+ * @brief Shorten a string without reallocation
+ * @param str The string
+ * @param length The new length (not greater than the current one)
+ */
+void truncate(OString& str, size_t length) {
+#ifdef ARDUINO
+    str.remove(length);
+#else
+    str.resize(length);
+#endif
+}
+
+/**
+ * @brief Find the next component of a path (empty components are skipped)
+ * @param path The path
+ * @param position Where to start the search, moved to the end of the component
+ * @return The component, empty at the end of the path
+ */
+std::string_view nextComponent(std::string_view path, size_t& position) {
+    while (position < path.size() && path[position] == '/')
+        ++position;
+    size_t begin = position;
+    while (position < path.size() && path[position] != '/')
+        ++position;
+    return path.substr(begin, position - begin);
+}
+
+/**
+ * @brief Find the last component of a path
+ * @param path The path
+ * @param previousEnd Set to the end of the component before the last one (0 if none)
+ * @return The last component, empty if none
+ */
+std::string_view lastComponent(std::string_view path, size_t& previousEnd) {
+    std::string_view last;
+    size_t lastEnd = 0;
+    previousEnd    = 0;
+    size_t position = 0;
+    for (auto item = nextComponent(path, position); !item.empty(); item = nextComponent(path, position)) {
+        previousEnd = lastEnd;
+        lastEnd     = position;
+        last        = item;
+    }
+    return last;
+}
+
+}// namespace
+
 [[nodiscard]] bool Path::isAbsolute() const { return internalPath[0] == '/'; }
 
 bool Path::isRoot() const { return internalPath == "/"; }
@@ -17,44 +91,65 @@ bool Path::isRoot() const { return internalPath == "/"; }
 void Path::makeRelative(const Path& relPath) {
     if (!isAbsolute() || !relPath.isAbsolute())
         return;
-    if (relPath.internalPath == "/") {
-        internalPath.erase(internalPath.begin());
-        return;
-    }
-    auto items     = data::split(internalPath, "/");
-    auto relatives = data::split(relPath.internalPath, "/");
-    bool start     = true;
-    for (const auto& r : relatives) {
-        if (start) {
-            if (items.front() == r) {
-                items.erase(items.begin());
-            } else {
-                start = false;
-                items.insert(items.begin(), "..");
+    // skip the common components
+    auto path      = view(internalPath);
+    auto relative  = view(relPath.internalPath);
+    size_t common  = 0;
+    size_t pos     = 0;
+    size_t relPos  = 0;
+    size_t upCount = 0;
+    for (auto relItem = nextComponent(relative, relPos); !relItem.empty(); relItem = nextComponent(relative, relPos)) {
+        if (upCount == 0) {
+            size_t next = pos;
+            if (nextComponent(path, next) == relItem) {
+                pos = common = next;
+                continue;
             }
-        } else {
-            items.insert(items.begin(), "..");
         }
+        ++upCount;
+    }
+    // the result is one "../" per remaining relative component then the rest of this path
+    while (common < path.size() && path[common] == '/')
+        ++common;
+    size_t restLength = path.size() - common;
+    size_t newLength  = 3 * upCount + restLength;
+    if (restLength == 0 && upCount > 0)
+        --newLength;
+    if (newLength > path.size()) {
+        internalPath.reserve(newLength);
+        while (internalPath.length() < newLength)
+            internalPath += '.';
     }
-    internalPath = data::merge(items, "/");
+    char* chars = buffer(internalPath);
+    std::memmove(chars + newLength - restLength, chars + common, restLength);
+    for (size_t up = 0; up < upCount; ++up) {
+        std::memcpy(chars + 3 * up, "../", std::min<size_t>(3, newLength - 3 * up));
+    }
+    truncate(internalPath, newLength);
     compact();
 }
 
 void Path::makeAbsolute(const Path& CurrentPath) {
     if (isAbsolute())
         return;
-    internalPath = CurrentPath.internalPath + "/" + internalPath;
+    // append the current path then move it in front
+    size_t length = internalPath.length();
+    internalPath.reserve(length + CurrentPath.internalPath.length() + 1);
+    internalPath += CurrentPath.internalPath;
+    internalPath += '/';
+    char* chars = buffer(internalPath);
+    std::rotate(chars, chars + length, chars + internalPath.length());
     compact();
 }
 
 Path& Path::operator/=(const Path& next) {
-    internalPath += OString("/") + next.internalPath;
-    compact();
-    return *this;
+    return *this /= next.internalPath;
 }
 
 Path& Path::operator/=(const OString& next) {
-    internalPath += OString("/") + next;
+    internalPath.reserve(internalPath.length() + next.length() + 1);
+    internalPath += '/';
+    internalPath += next;
     compact();
     return *this;
 }
@@ -74,82 +169,99 @@ Path Path::operator/(const OString& next) const {
 void Path::compact() {
     if (isRoot())
         return;
-    auto items = data::split(internalPath, "/");
-    std::vector<OString> filtered;
-    std::vector<OString>::size_type min_id = 0;
-    bool increment                             = !isAbsolute();
-    for (auto& item : items) {
-        if (item == "." && !(increment && filtered.empty()))
+    bool absolute = isAbsolute();
+    auto path     = view(internalPath);
+    char* chars   = buffer(internalPath);
+    // the components are written back over the ones already read
+    size_t start    = absolute ? 1 : 0;
+    size_t write    = start;
+    size_t kept     = 0;
+    size_t minKept  = 0;
+    bool leading    = !absolute;
+    size_t position = 0;
+    for (auto item = nextComponent(path, position); !item.empty(); item = nextComponent(path, position)) {
+        bool dot    = item == ".";
+        bool dotDot = item == "..";
+        // a relative path keeps its leading "./" and "../"
+        if (dot && !(leading && kept == 0))
             continue;
-        if (item == ".." && !increment) {
-            if (filtered.size() > min_id)
-                filtered.pop_back();
-            continue;
-        }
-        if (increment) {
-            if (item == ".." || item == ".") {
-                ++min_id;
-            } else {
-                increment = false;
+        if (dotDot && !leading) {
+            if (kept > minKept) {
+                --kept;
+                while (write > start && chars[write - 1] != '/')
+                    --write;
+                if (write > start)
+                    --write;
             }
+            continue;
         }
-        filtered.push_back(item);
-    }
-    if (isAbsolute()) {
-        internalPath = "/";
-    } else {
-        internalPath = "";
+        if (leading && !dot && !dotDot)
+            leading = false;
+        else if (leading)
+            ++minKept;
+        if (kept > 0)
+            chars[write++] = '/';
+        std::memmove(chars + write, item.data(), item.size());
+        write += item.size();
+        ++kept;
     }
-    internalPath += data::merge(filtered, "/");
-    if (internalPath.empty())
+    truncate(internalPath, write);
+    if (write == 0)
         internalPath = ".";
 }
 
 Path Path::parent() const {
     if (isRoot())
         return {};
-    auto items = data::split(internalPath, "/");
-    if (items.size() == 1) {
+    size_t previousEnd = 0;
+    lastComponent(view(internalPath), previousEnd);
+    if (previousEnd == 0) {
         if (isAbsolute())
             return {};
         return {*this};
     }
-    Path result;
-    if (!isAbsolute())
-        result.internalPath = "";
-    result.internalPath += data::merge(items.begin(), items.end() - 1, "/");
-    return result;
+    return Path(OString(internalPath.c_str(), previousEnd));
 }
 
-OString Path::name() const { return data::split(internalPath, "/").back(); }
+OString Path::name() const {
+    size_t previousEnd = 0;
+    return OString(lastComponent(view(internalPath), previousEnd));
+}
 
 OString Path::baseName() const {
     OString _name = name();
-    return data::split(_name, ".").front();
+    auto chars    = view(_name);
+    size_t begin  = std::min(chars.find_first_not_of('.'), chars.size());
+    size_t end    = std::min(chars.find('.', begin), chars.size());
+    return OString(chars.substr(begin, end - begin));
 }
 
 OString Path::suffix() const {
     OString _name = name();
-    if (_name.find('.') == OString::npos)
+    size_t dot    = view(_name).rfind('.');
+    if (dot == std::string_view::npos)
         return "";
-    return OString(".") + data::split(_name, ".").back();
+    return OString(view(_name).substr(dot));
 }
 
 OString Path::suffixes() const {
     OString _name = name();
-    if (_name.find('.') == OString::npos)
+    auto chars    = view(_name);
+    size_t begin  = std::min(chars.find_first_not_of('.'), chars.size());
+    size_t dot    = chars.find('.', begin);
+    if (dot == std::string_view::npos)
         return "";
-    auto items = data::split(_name, ".");
-    return OString(".") + data::merge(items.begin() + 1, items.end(), ".");
+    return OString(chars.substr(dot));
 }
 
 #ifndef ARDUINO
 
 std::filesystem::path Path::toStdPath() const {
-    auto items = data::split(internalPath, "/");
+    auto path = view(internalPath);
     std::filesystem::path result;
-    for (const auto& item : items) {
-        result /= item.s_str();
+    size_t position = 0;
+    for (auto item = nextComponent(path, position); !item.empty(); item = nextComponent(path, position)) {
+        result /= item;
     }
     return result;
 }
@@ -17,6 +17,9 @@ namespace obd::fs {
 
 /**
  * @brief Class handling file path
+ *
+ * The path is kept in a single string: the components are found by scanning
+ * it, and the normalizations rewrite it in place instead of splitting it.
  */
 class Path {
 public:
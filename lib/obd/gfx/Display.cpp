@@ -7,6 +7,7 @@
  */
 
 #include "gfx/Display.h"
+#include "core/timer/VirtualClock.h"
 #ifdef ARDUINO
 #include <SPI.h>
 #endif
@@ -14,6 +15,25 @@
 namespace obd::gfx {
 
 bool Display::begin(const Resolution& displayMode) {
+    bootMode = displayMode;
+    bootStep = BootStep::Reset;
+    core::driver::InitStatus result;
+    while ((result = bringUp()) == core::driver::InitStatus::Pending) {
+        uint64_t date = core::timer::now();
+        core::timer::idle(initRetryDate() > date ? initRetryDate() - date : 0);
+    }
+    return result == core::driver::InitStatus::Done;
+}
+
+core::driver::InitStatus Display::initStep() {
+    core::driver::InitStatus result = bringUp();
+    if (result != core::driver::InitStatus::Done)
+        return result;
+    init();
+    return initialized() ? core::driver::InitStatus::Done : core::driver::InitStatus::Failed;
+}
+
+bool Display::applyResolution(const Resolution& displayMode) {
     if (displayMode == Resolution::DM_480x80) {
         resolution.x = 480;
         resolution.y = 80;
@@ -29,30 +49,75 @@ bool Display::begin(const Resolution& displayMode) {
     } else {
         return false;
     }
-#ifdef ARDUINO
-    if (_cs != 255) {
-        pinMode(_cs, OUTPUT);
-        digitalWrite(_cs, HIGH);
-        hardReset();
+    return true;
+}
 
-        SPI.begin();
-    }
+core::driver::InitStatus Display::bringUp() {
+    switch (bootStep) {
+    case BootStep::Reset:
+        if (!applyResolution(bootMode))
+            return core::driver::InitStatus::Failed;
+        bootStep = BootStep::Probe;
+#ifdef ARDUINO
+        if (_cs != 255) {
+            pinMode(_cs, OUTPUT);
+            digitalWrite(_cs, HIGH);
+            // hard reset: the reset pin stays low for 100ms
+            if (_rst != 255) {
+                pinMode(_rst, OUTPUT);
+                digitalWrite(_rst, HIGH);
+                digitalWrite(_rst, LOW);
+                bootStep = BootStep::ResetRelease;
+                return retryIn(100000);
+            }
+        }
 #endif
-    setSpiSpeed(SpiSpeed::SpiSlow);
-    uint8_t idReg = readReg(Registers::RID);
-    if (idReg != ra8875_id) {// check if we really have a RA8875 online!!
-        Message msg(type(),getConsoleId());
-        msg.print("ERROR no RA8875 device found: ");
-        msg.println(idReg);
-        msg.setType(Message::MessageType::Error);
-        broadcastMessage(msg);
-        return false;
+        return bringUp();
+    case BootStep::ResetRelease:
+#ifdef ARDUINO
+        digitalWrite(_rst, HIGH);
+#endif
+        bootStep = BootStep::Probe;
+        return retryIn(100000);
+    case BootStep::Probe:
+#ifdef ARDUINO
+        if (_cs != 255)
+            SPI.begin();
+#endif
+        setSpiSpeed(SpiSpeed::SpiSlow);
+        if (uint8_t idReg = readReg(Registers::RID); idReg != ra8875_id) {// check if we really have a RA8875 online!!
+            Message msg(id(), getConsoleId());
+            msg.print("ERROR no RA8875 device found: ");
+            msg.println(idReg);
+            msg.setType(Message::MessageType::Error);
+            broadcastMessage(msg);
+            bootStep = BootStep::Reset;
+            return core::driver::InitStatus::Failed;
+        }
+        // now initialize the device!
+        PLLInit();
+        bootStep = BootStep::PllDivider;
+        return retryIn(1000);
+    case BootStep::PllDivider:
+        writeReg(Registers::PLLC2, 0x02);// divide by 4
+        bootStep = BootStep::PixelClock;
+        return retryIn(1000);
+    case BootStep::PixelClock:
+        initialize();
+        bootStep = BootStep::Timings;
+        return retryIn(1000);
+    case BootStep::Timings:
+        writeTimings();
+        bootStep = BootStep::Clear;
+        // the clear of the full memory takes a while
+        return retryIn(500000);
+    case BootStep::Clear:
+        break;
     }
-    // now initialize the device!
-    initialize();
     // Set SPI clock to normal speed
     setSpiSpeed(SpiSpeed::SpiNormal);
-    return true;
+    bootStep = BootStep::Reset;
+    return core::driver::InitStatus::Done;
 }
 
 void Display::PLLInit() {
@@ -61,38 +126,21 @@ void Display::PLLInit() {
     // Fin is given by the external cristal
     // PLLDIVM : bit 7 of register PLLC1
     // PLLDIVN : bits 4-0 of register PLLC1
-    // PLLDIVK : bits 2-0 of register PLLC2
+    // PLLDIVK : bits 2-0 of register PLLC2 (written at the next step)
     // min SYS_clock is 1MHz max is 60MHz (typical is 20-30MHz)
     // Fin is typically 15-30MHz
 
     uint8_t PllDivM = 0;
     uint8_t PllDivN = 10;
-    uint8_t PllDivK = 0x02;// divide by 4
 
     if (resolution.y != 480) {
         writeReg(Registers::PLLC1, (PllDivM << 7) + PllDivN);
-#ifdef ARDUINO
-        delay(1);
-#endif
-        writeReg(Registers::PLLC2, PllDivK);
-#ifdef ARDUINO
-        delay(1);
-#endif
-        // SYS_CLK =
     } else /* (_size == RA8875_800x480) */ {
         writeReg(Registers::PLLC1, (PllDivM << 7) + PllDivN + 1);
-#ifdef ARDUINO
-        delay(1);
-#endif
-        writeReg(Registers::PLLC2, PllDivK);
-#ifdef ARDUINO
-        delay(1);
-#endif
     }
 }
 
 void Display::initialize() {
-    PLLInit();
     //
     // System Register
     // set to 16bit color, 8 bit MCU. (values from adafruit, todo: Test other
@@ -102,15 +150,20 @@ void Display::initialize() {
     //
     // Pixel clock
     // (values from adafruit, todo: Test other values!)
-    uint8_t pixclk         = 0x80;// falling edge
-    uint8_t hsync_nondisp  = 10;  // I don't know the effect.
-    uint8_t hsync_start    = 8;   // I don't know the effect.
-    uint8_t hsync_pw       = 48;  // I don't know the effect.
-    uint16_t vsync_nondisp = 3;   // I don't know the effect.
-    uint16_t vsync_start   = 8;   // I don't know the effect.
-    uint8_t vsync_pw       = 10;  // I don't know the effect.
-    if (resolution.y == 480) {
+    uint8_t pixclk = 0x80;// falling edge
+    if (resolution.y == 480)
         pixclk += 0b10;// divide sys_clock frequency by 2
+    writeReg(Registers::PCSR, pixclk);
+}
+
+void Display::writeTimings() {
+    uint8_t hsync_nondisp  = 10;// I don't know the effect.
+    uint8_t hsync_start    = 8; // I don't know the effect.
+    uint8_t hsync_pw       = 48;// I don't know the effect.
+    uint16_t vsync_nondisp = 3; // I don't know the effect.
+    uint16_t vsync_start   = 8; // I don't know the effect.
+    uint8_t vsync_pw       = 10;// I don't know the effect.
+    if (resolution.y == 480) {
         hsync_nondisp = 26;
         hsync_start   = 32;
         hsync_pw      = 96;
@@ -118,10 +171,6 @@ void Display::initialize() {
         vsync_start   = 23;
         vsync_pw      = 2;
     }
-    writeReg(Registers::PCSR, pixclk);
-#ifdef ARDUINO
-    delay(1);
-#endif
 
     //
     // Horizontal settings
@@ -176,9 +225,6 @@ void Display::initialize() {
     //
     // Clear the screen (full memory)
     writeReg(Registers::MCLR, 0x80);
-#ifdef ARDUINO
-    delay(500);
-#endif
 }
 
 void Display::display(bool active, bool sleep) {
@@ -206,19 +252,6 @@ void Display::softReset() {
 #endif
 }
 
-void Display::hardReset() {
-    if (_rst == 255)
-        return;
-#ifdef ARDUINO
-    pinMode(_rst, OUTPUT);
-    digitalWrite(_rst, HIGH);
-    digitalWrite(_rst, LOW);
-    delay(100);
-    digitalWrite(_rst, HIGH);
-    delay(100);
-#endif
-}
-
 void Display::backlight(uint8_t percent) {
     if (percent == 0) {
         writeReg(Registers::P1CR, (_pwmClock & 0xF));
@@ -431,7 +464,7 @@ void Display::setSpiSpeed(const SpiSpeed& spd, uint32_t custom_speed) {
 }
 
 void Display::printRegister(const Registers& reg) const {
-    Message msg(type(),getConsoleId());
+    Message msg(id(), getConsoleId());
     auto val = static_cast<uint8_t>(reg);
     msg.print("0x");
     msg.print(val, Message::Format::Hexadecimal);
@@ -445,7 +478,7 @@ void Display::printRegister(const Registers& reg) const {
 }
 
 void Display::printStatusRegisters() const {
-    Message msg(type(),getConsoleId());
+    Message msg(id(), getConsoleId());
     msg.print("Status : ");
     uint8_t val = readStatus();
     msg.print("0x");
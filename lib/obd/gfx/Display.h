@@ -39,7 +39,7 @@ public:
      * @param rst The reset pin
      */
     explicit Display(std::shared_ptr<Messenger> parent = nullptr, uint8_t cs = 255, uint8_t rst = 255) :
-        Node(parent),
+        Node(parent, queueStorage),
         _cs{cs}, _rst{rst} {
     }
 
@@ -54,13 +54,19 @@ public:
     };
 
     /**
-   * @brief Initialize display
+   * @brief Initialize display, blocking until the device is ready (see initStep)
    * @param displayMode The display mode
    * @return False if something go wrong or display not
    * present
    */
     bool begin(const Resolution& displayMode = Resolution::DM_800x480);
 
+    /**
+     * @brief Bring the display up without blocking, with the resolution of the last begin()
+     * @return Pending while waiting for the device
+     */
+    core::driver::InitStatus initStep() override;
+
     /**
    * @brief Define SPI speed
    * @param spd The predefined speed
@@ -88,10 +94,6 @@ public:
    * @brief Do a reset of the screen
    */
     void softReset();
-    /**
-   * @brief Do a hard reset of the screen (using reset pin)
-   */
-    void hardReset();
 
     /**
    * @brief Set the backlight
@@ -318,6 +320,9 @@ public:
     void clearTouch();
 
 private:
+    /// Storage of the message queue
+    QueueStorage<config::displayQueueLength> queueStorage;
+
     /// The Cable Select pin
     uint8_t _cs;
     /// The reset pin
@@ -334,15 +339,50 @@ private:
     TouchMode touchMode = TouchMode::Auto;
 
     /**
-   * @brief Initialize the device
+     * @brief Steps of the device bring-up
+     */
+    enum struct BootStep : uint8_t {
+        Reset,       ///< Start the hard reset
+        ResetRelease,///< End the hard reset
+        Probe,       ///< Check the device, set the PLL multiplier
+        PllDivider,  ///< Set the PLL divider
+        PixelClock,  ///< Set the color depth and the pixel clock
+        Timings,     ///< Set the display timings, the windows and clear the memory
+        Clear,       ///< Wait for the end of the memory clear
+    };
+    /// Next step of the bring-up
+    BootStep bootStep = BootStep::Reset;
+    /// Resolution to apply at the bring-up
+    Resolution bootMode = Resolution::DM_800x480;
+
+    /**
+   * @brief Do a step of the device's bring-up
+   * @return Pending while waiting for the device
+   */
+    core::driver::InitStatus bringUp();
+
+    /**
+   * @brief Define the screen resolution
+   * @param displayMode The display mode
+   * @return False if the mode is unknown
+   */
+    bool applyResolution(const Resolution& displayMode);
+
+    /**
+   * @brief Set the color depth and the pixel clock
    */
     void initialize();
 
     /**
-   * @brief Initialize the PLL
+   * @brief Set the PLL multiplier
    */
     void PLLInit();
 
+    /**
+   * @brief Set the display timings and the windows, start the memory clear
+   */
+    void writeTimings();
+
     /// The registers
     enum struct Registers {
         /// Register for getting the ID of the device: should be equal to 0x75
@@ -9,6 +9,7 @@
 #include "StatusLed.h"
 #include "native/fakeArduino.h"
 #include "config.h"
+#include <iterator>
 
 namespace obd::config {
 constexpr uint64_t ledHalfPeriod         = ledPeriod / 2;    ///< half period time
@@ -30,8 +31,11 @@ void StatusLed::init() {
 }
 
 void StatusLed::preTreatment() {
-    ledTime += micros() - timestamp;
-    timestamp = micros();
+    // all the patterns change on eighths of period
+    ledTime = (ledTime + timerExpired(ledTimer) * config::ledEighthPeriod) % config::ledPeriod;
+}
+
+void StatusLed::postTreatment() {
     uint8_t state{0};
     switch (ledState) {
     case LedState::Off:
@@ -54,46 +58,33 @@ void StatusLed::preTreatment() {
     case LedState::FasterBlink:
         state = fasterBlinkCb();
     }
+    ledLight = state == 1;
 #ifdef ARDUINO
     digitalWrite(LED_BUILTIN, static_cast<uint8_t>(1U - state));
-#else
-    if (state == 1) {
-    }
 #endif
-    while (ledTime > config::ledPeriod) {
-        ledTime -= config::ledPeriod;
-    }
 }
 
-bool StatusLed::treatMessage(const Message& cmd){
-    if (Node::treatMessage(cmd))
-        return true;
-    if (cmd.getBaseCommand()==F("led")) {
-        if (!cmd.hasParams()) {
-            printCurrentState();
-        } else {
-            OString buf{cmd.getParams()[0]};
-            if (buf == F("off")) {
-                setState();
-            } else if (buf == F("solid")) {
-                setState(LedState::Solid);
-            } else if (buf == F("blink")) {
-                setState(LedState::Blink);
-            } else if (buf == F("fastblink")) {
-                setState(LedState::FastBlink);
-            } else if (buf == F("twopulse")) {
-                setState(LedState::TwoPulse);
-            } else if (buf == F("threepulse")) {
-                setState(LedState::ThreePulses);
-            } else if (buf == F("fasterblink")) {
-                setState(LedState::FasterBlink);
-            } else {
-                console("Unknown led State", Message::MessageType::Error);
-            }
-        }
-        return true;
+core::driver::CommandTable StatusLed::commands() const {
+    // in the LedState order
+    static constexpr const char* states[] = {"off", "solid", "blink", "fastblink", "twopulse", "threepulse", "fasterblink"};
+    static_assert(std::size(states) == static_cast<size_t>(LedState::FasterBlink) + 1, "one keyword per led state");
+    static constexpr core::driver::CommandEntry table[] = {
+            {Commands::Led, "led", 0, core::driver::commandHandler<&StatusLed::cmdLed>(), "[off|solid|blink|fastblink|twopulse|threepulse|fasterblink] Print or set the led state", states},
+    };
+    static_assert(core::driver::CommandTable::sorted(table), "commands must be sorted by id");
+    return table;
+}
+
+void StatusLed::cmdLed(const Message& cmd) {
+    const Command& command = cmd.getCommand();
+    if (!command.hasArgument()) {
+        printCurrentState();
+    } else if (command.validArgument()) {
+        // argument keywords follow the LedState order (see commands())
+        setState(static_cast<LedState>(command.argument));
+    } else {
+        console("Unknown led State", Message::MessageType::Error);
     }
-    return false;
 }
 
 void StatusLed::setState(LedState newState) {
@@ -102,11 +93,16 @@ void StatusLed::setState(LedState newState) {
     if (ledState == newState)
         return;
     ledState = newState;
-    ledTime = 0;
+    ledTime  = 0;
+    stopTimer(ledTimer);
+    if (ledState != LedState::Off && ledState != LedState::Solid)
+        ledTimer = startTimer(config::ledEighthPeriod, config::ledEighthPeriod);
+    // refresh the led at the next frame
+    notify();
 }
 
 void StatusLed::printCurrentState() {
-    Message msg(type(), getConsoleId());
+    Message msg(id(), getConsoleId());
     switch (ledState) {
     case LedState::Off:
         msg.println(F("LED state: off"));
@@ -185,18 +181,4 @@ uint8_t StatusLed::fasterBlinkCb() const {
     return 0;
 }
 
-void StatusLed::accelerateTime(uint64_t addedTime) {
-    ledTime += addedTime;
-}
-
-bool StatusLed::pushCommand(const core::driver::Message& message) {
-    if (Node::pushCommand(message))
-        return true;
-    if (message.getBaseCommand() == F("led")) {
-        getMessages().push(message);
-        return true;
-    }
-    return false;
-}
-
 }// namespace obd::gfx
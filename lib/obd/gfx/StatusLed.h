@@ -30,12 +30,23 @@ enum struct LedState {
  */
 class StatusLed : public core::driver::Node {
 public:
+    /**
+     * @brief Ids of the led's own commands
+     */
+    struct Commands {
+        static constexpr CommandId Led = core::driver::nodeCommand(0);///< Print or set the led state
+    };
+
     /**
      * @brief Constructor with parent
      * @param parent The parent system
      */
     explicit StatusLed(std::shared_ptr<Messenger> parent) :
-        Node(parent){};
+        Node(parent, queueStorage) {
+        // woken up by the led timer
+        setSchedule(0, 200);
+        setWakeups(core::driver::Wakeup::Message);
+    }
 
     /**
      * @brief Initialize the driver
@@ -55,28 +66,40 @@ public:
     [[nodiscard]] const LedState& state()const{return ledState;}
 
     /**
-     * @brief Append some time to the chronometer
-     * @param addedTime The time to add
+     * @brief Check if the LED is lit
+     * @return True if lit
      */
-    void accelerateTime(uint64_t addedTime);
+    [[nodiscard]] bool lit() const { return ledLight; }
 private:
+    /// Storage of the message queue
+    QueueStorage<config::ledQueueLength> queueStorage;
+
     /**
      * @brief Print the current state of the LED
      */
     void printCurrentState();
 
     /**
-     * @brief Procedure called each frame
-     * @param delta The time delta from last update
+     * @brief Account the elapsed eighths of period
      */
     void preTreatment() override;
 
     /**
-     * @brief Try to treat the given command
-     * @param cmd The command to treat
-     * @return True if the command has been treated
+     * @brief Light the LED according to the state and the time
+     */
+    void postTreatment() override;
+
+    /**
+     * @brief Get the led commands
+     * @return The command table
      */
-    bool treatMessage(const Message& cmd) override;
+    [[nodiscard]] core::driver::CommandTable commands() const override;
+
+    /**
+     * @brief Command 'led': print or change the led state
+     * @param cmd The command
+     */
+    void cmdLed(const Message& cmd);
 
     /**
      * @brief Callback function giving the LED fast blinking light according to the ledTimer
@@ -101,21 +124,18 @@ private:
      * @return Led light value
      */
     [[nodiscard]] uint8_t fasterBlinkCb() const;
-    /**
-     * @brief Send a message to this driver
-     * @param message The Command message to send
-     * @return True mean command caught.
-     */
-    bool pushCommand(const Message& message) override;
 
     /// Current state of the led
     LedState ledState = LedState::Off;
 
-    /// Internal timestamp
-    uint64_t timestamp = 0;
+    /// Timer of the blinking states
+    TimerId ledTimer = core::timer::TimerService::invalidTimer;
 
     /// Chronometer for led
     uint64_t ledTime = 0;
+
+    /// If the LED is lit
+    bool ledLight = false;
 };
 
 }// namespace obd::gfx
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <string_view>
 #ifdef ARDUINO
 #include <WString.h>
 #else
@@ -46,6 +47,8 @@ public:
 #ifdef ARDUINO
     using size_type = unsigned int;
     OString(const char* str):String(str){}
+    OString(const char* str, size_type count){concat(str, count);}
+    explicit OString(std::string_view str){concat(str.data(), str.size());}
     OString(const String& str):String(str){}
     OString(const __FlashStringHelper *str):String(str){}
     OString(int number):String(number) {}
@@ -64,6 +67,17 @@ public:
      * @param str The origin string
      */
     OString(const char* str):std::string(str){}
+    /**
+     * @brief Constructor from a part of a char array
+     * @param str The origin chars
+     * @param count The number of chars
+     */
+    OString(const char* str, size_type count):std::string(str, count){}
+    /**
+     * @brief Constructor from a string view
+     * @param str The origin chars
+     */
+    explicit OString(std::string_view str):std::string(str){}
     /**
      * @brief Constructor by std::string
      * @param str The origin string
@@ -9,6 +9,7 @@
 #include "data/DataUtils.h"
 #include "fs/ConfigFile.h"
 #include "native/fakeArduino.h"
+#include <string>
 #include <sys/time.h>
 
 namespace obd::time {
@@ -18,12 +19,30 @@ void Clock::init() {
     Node::init();
     if (!initialized())
         return;
+    stopTimer(saveTimer);
+    saveTimer = startTimer(config::saveInterval, config::saveInterval);
     if (!checkFs() )
         return;
     loadConfig();
     configTime();
 }
 
+bool Clock::linkNode(const std::shared_ptr<Node>& node) {
+    if (Node::linkNode(node)) {
+        return true;
+    }
+    if (node->type() == code<fs::FileSystem>()) {
+        fileSystem = std::static_pointer_cast<fs::FileSystem>(node);
+        // file system initialized after the clock: restore the saved state now
+        if (initialized() && checkFs()) {
+            loadConfig();
+            configTime();
+        }
+        return true;
+    }
+    return false;
+}
+
 bool Clock::checkFs() const{
     if (!fileSystem)
         return false;
@@ -46,7 +65,7 @@ void Clock::configTime() {
 #endif
 }
 
-OString Clock::info()const {
+core::driver::Message::DataType Clock::info()const {
     OString result;
     result = "----- CLOCK INFORMATION -----\n" ;
     result += OString("Pool server       : ") + poolServerName + "\n";
@@ -55,67 +74,37 @@ OString Clock::info()const {
 }
 
 void Clock::preTreatment() {
-    uint64_t timeStamp = micros();
-    int64_t delta = static_cast<int64_t>(timeStamp) - static_cast<int64_t>(timestamp);
-    timestamp    = timeStamp;
-    chronometer += delta;
-    if (chronometer >= config::saveInterval) {
-        chronometer = 0;
+    if (timerExpired(saveTimer) > 0) {
         // save current time so next boot will be loaded
         if (checkFs()){
             fs::TextFile timeFile(fileSystem, fs::Path(config::tsSave), fs::ios::out);
             time_t date = getDate();
-            timeFile.write(OString(date));
+            timeFile.write(OString(std::to_string(date)));
             timeFile.close();
         }
     }
 }
 
-bool Clock::treatMessage(const Message& message) {
-    if (Node::treatMessage(message)){
-        return true;
-    }
-    if (message.getType() == Message::MessageType::Command) {
-        if (message.getBaseCommand() == F("date")) {
-            broadcastMessage(message.getSource(), getDateFormatted(), MessageType::Reply);
-            return true;
-        }
-        if (message.getBaseCommand() == F("pool")) {
-            if (message.hasParams()) {
-                setPoolServer(message.getParams()[0]);
-            }else{
-                broadcastMessage(message.getSource(), "pool: need a parameter", MessageType::Error);
-            }
-            return true;
-        }
-        if (message.getBaseCommand() == F("zone")) {
-            if (message.hasParams()) {
-                setTimeZone(message.getParams()[0]);
-            }else{
-                broadcastMessage(message.getSource(), "zone: need a parameter", MessageType::Error);
-            }
-            return true;
-        }
-    }
-    return false;
+core::driver::CommandTable Clock::commands() const {
+    static constexpr core::driver::CommandEntry table[] = {
+            {Commands::Date, "date", 0, core::driver::commandHandler<&Clock::cmdDate>(), "Print the current date", {}},
+            {Commands::Pool, "pool", 1, core::driver::commandHandler<&Clock::cmdPool>(), "<server> Define the time server", {}},
+            {Commands::Zone, "zone", 1, core::driver::commandHandler<&Clock::cmdZone>(), "<zone> Define the time zone", {}},
+    };
+    static_assert(core::driver::CommandTable::sorted(table), "commands must be sorted by id");
+    return table;
 }
 
-bool Clock::pushCommand(const Message& message) {
-    if (Node::pushCommand(message))
-        return true;
-    if (message.getBaseCommand() == F("date")) {
-        getMessages().push(message);
-        return true;
-    }
-    if (message.getBaseCommand() == F("pool")) {
-        getMessages().push(message);
-        return true;
-    }
-    if (message.getBaseCommand() == F("zone")) {
-        getMessages().push(message);
-        return true;
-    }
-    return false;
+void Clock::cmdDate(const Message& message) {
+    broadcastMessage(message.getSource(), getDateFormatted(), MessageType::Reply);
+}
+
+void Clock::cmdPool(const Message& message) {
+    setPoolServer(OString{message.getWords(1)[0]});
+}
+
+void Clock::cmdZone(const Message& message) {
+    setTimeZone(OString{message.getWords(1)[0]});
 }
 
 void Clock::loadConfig() {
@@ -170,8 +159,4 @@ OString Clock::formatTime(const time_t& time) {
     return tStr;
 }
 
-void Clock::accelerateTime(uint64_t addedTime) {
-    chronometer += addedTime;
-}
-
 }// namespace obd::time
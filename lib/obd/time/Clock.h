@@ -26,12 +26,27 @@ const OString TZ_Europe_Paris = "CET-1CEST,M3.5.0,M10.5.0/3";
  */
 class Clock : public core::driver::Node {
 public:
+    /**
+     * @brief Ids of the clock's own commands
+     */
+    struct Commands {
+        static constexpr CommandId Date = core::driver::nodeCommand(0);///< Print the current date
+        static constexpr CommandId Pool = core::driver::nodeCommand(1);///< Define the time server
+        static constexpr CommandId Zone = core::driver::nodeCommand(2);///< Define the time zone
+    };
+
     /**
      * @brief Constructor with parent system
      * @param parent The parent system
      */
     explicit Clock(std::shared_ptr<Messenger> parent) :
-        Node{std::move(parent)}{}
+        Node{std::move(parent), queueStorage} {
+        // woken up by the save timer, a run may save the timestamp in a file
+        setSchedule(0, 5000);
+        setWakeups(core::driver::Wakeup::Message);
+        // the timestamp is saved in a file, when there is a file system
+        dependsOnOptional<fs::FileSystem>();
+    }
 
     /**
      * @brief Initialize the driver
@@ -42,7 +57,7 @@ public:
      * @brief Return the driver infos
      * @return The driver's infos.
      */
-    [[nodiscard]] OString info()const override;
+    [[nodiscard]] Message::DataType info()const override;
 
     /**
      * @brief Load and apply parameters in the config file
@@ -54,6 +69,13 @@ public:
      */
     void saveConfig() const override;
 
+    /**
+     * @brief Try to link the given node
+     * @param node The node to link to this one
+     * @return True if linked
+     */
+    bool linkNode(const std::shared_ptr<Node>& node) override;
+
     /**
      * @brief Formatting a given time
      * @param time The time to format
@@ -97,13 +119,10 @@ public:
      */
     [[nodiscard]] const OString & getTimeZone()const {return _timeZone;}
 
-    /**
-     * @brief Append some time to the chronometer
-     * @param addedTime The time to add
-     */
-    void accelerateTime(uint64_t addedTime);
-
 private:
+    /// Storage of the message queue
+    QueueStorage<config::clockQueueLength> queueStorage;
+
 
     /**
      * @brief What to do before message treatment
@@ -115,17 +134,25 @@ private:
      */
     void configTime();
     /**
-     * @brief Send a message to this driver
-     * @param message The Command message to send
-     * @return True mean command caught.
+     * @brief Get the clock commands
+     * @return The command table
+     */
+    [[nodiscard]] core::driver::CommandTable commands() const override;
+    /**
+     * @brief Command 'date': reply the current date
+     * @param message The command
      */
-    bool pushCommand(const Message& message) override;
+    void cmdDate(const Message& message);
     /**
-     * @brief Try to treat the given command
-     * @param cmd The command to treat
-     * @return True if the command has been treated
+     * @brief Command 'pool': define the time server
+     * @param message The command
      */
-    bool treatMessage(const Message& message) override;
+    void cmdPool(const Message& message);
+    /**
+     * @brief Command 'zone': define the time zone
+     * @param message The command
+     */
+    void cmdZone(const Message& message);
 
     /// link to filesystem
     std::shared_ptr<fs::FileSystem> fileSystem = nullptr;
@@ -141,11 +168,8 @@ private:
     /// Timezone configuration string
     OString _timeZone = TZ_Europe_Paris;
 
-    /// Internal timestamp
-    uint64_t timestamp = 0;
-
-    /// Internal timer
-    uint64_t chronometer = 0;
+    /// Timer of the timestamp save
+    TimerId saveTimer = core::timer::TimerService::invalidTimer;
 };
 
 }// namespace obd::time
@@ -1,18 +1,22 @@
 
 #include "native/fakeArduino.h"
+#include "com/Stdout.h"
 #include "gfx/StatusLed.h"
 //#include "gfx/Display.h"
-#include <core/System.h>
-static obd::core::System hardware;
+#include <core/StaticSystem.h>
 
-void setup() {
 #if defined(ONBOARD)
+using Hardware = obd::core::StaticSystem<obd::gfx::StatusLed, obd::com::Shell, obd::com::Stdout>;
 #elif defined(REMOTE)
-    //hardware.addNode<obd::gfx::Display>();
+using Hardware = obd::core::StaticSystem<obd::gfx::StatusLed, obd::com::Shell, obd::com::Stdout/*, obd::gfx::Display*/>;
 #elif defined(NATIVE)
+using Hardware = obd::core::StaticSystem<obd::gfx::StatusLed, obd::com::Shell, obd::com::Stdout>;
 #else
 #error "Unsupported Pio Environment"
 #endif
+static Hardware hardware;
+
+void setup() {
     hardware.init();
 }
 
@@ -0,0 +1,103 @@
+/**
+ * @file test_bench_file.cpp
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+#include "../test_base.h"
+#include "core/driver/Manager.h"
+#include "core/driver/Messenger.h"
+#include "fs/File.h"
+#include "fs/FileSystem.h"
+#include <cstdio>
+#include <fstream>
+
+using namespace obd::fs;
+using namespace obd::core::driver;
+
+/// Size of the file read by the benchmark
+constexpr size_t benchFileSize = 100 * 1024;
+/// Number of reads of the file per benchmark
+constexpr int benchPasses = 10;
+/// Path of the benchmark's file
+const Path benchPath{"/bench.txt"};
+
+/**
+ * @brief Read a line the way TextFile did before the buffering: one stream read per char
+ * @param stream The file
+ * @return The line read
+ */
+OString charByCharLine(std::fstream& stream) {
+    OString result;
+    size_t count = 0;
+    do {
+        char readChar = 0;
+        stream.read(&readChar, 1);
+        result.push_back(readChar);
+        ++count;
+    } while (stream && result.back() != '\n' && count < 255);
+    return result;
+}
+
+/**
+ * @brief Print the throughput of a benchmark
+ * @param name The benchmark's name
+ * @param bytes The amount of data read
+ * @param elapsed The time in microseconds
+ */
+void report(const char* name, size_t bytes, uint64_t elapsed) {
+    char buffer[100];
+    snprintf(buffer, 100, "%s: %.1f MB/s", name, static_cast<double>(bytes) / static_cast<double>(elapsed > 0 ? elapsed : 1));
+    TEST_MESSAGE(buffer);
+}
+
+void test_readLines() {
+    auto mng = std::make_shared<Manager>();
+    auto msg = std::make_shared<Messenger>(mng);
+    auto hdd = std::make_shared<FileSystem>(msg);
+    mng->addNode(hdd);
+    mng->init();
+    TEST_ASSERT(hdd->initialized())
+    {
+        TextFile file(hdd, benchPath, ios::out);
+        OString line{"parameter = some value of a config file # and its comment\n"};
+        for (size_t size = 0; size < benchFileSize; size += line.size())
+            file.write(line);
+    }
+    size_t bytes = 0;
+    size_t lines = 0;
+
+    uint64_t start = micros64();
+    for (int pass = 0; pass < benchPasses; ++pass) {
+        std::fstream stream(hdd->toStdPath(benchPath), std::ios::in);
+        while (!stream.eof()) {
+            bytes += charByCharLine(stream).size();
+            ++lines;
+        }
+    }
+    report("char by char", bytes, micros64() - start);
+    size_t oldLines = lines;
+    bytes           = 0;
+    lines           = 0;
+
+    start = micros64();
+    for (int pass = 0; pass < benchPasses; ++pass) {
+        TextFile file(hdd, benchPath, ios::in);
+        while (file.available()) {
+            bytes += file.readLine().size();
+            ++lines;
+        }
+    }
+    report("buffered    ", bytes, micros64() - start);
+    TEST_ASSERT(bytes >= benchFileSize * benchPasses)
+    // the old path also returned an empty line at the end of the file
+    TEST_ASSERT_EQUAL(oldLines, lines + benchPasses);
+    TEST_ASSERT(hdd->rm(benchPath))
+}
+
+void test_all() {
+    UNITY_BEGIN();
+    RUN_TEST(test_readLines);
+    UNITY_END();
+}
@@ -0,0 +1,99 @@
+/**
+ * @file test_bench_message.cpp
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+#include "../test_base.h"
+#include "core/driver/Message.h"
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+
+using namespace obd::core::driver;
+
+/// Amount of message built per benchmark
+constexpr uint64_t benchLoops = 20000;
+
+/**
+ * @brief Former Message::print path: std::stringstream appended to an OString
+ */
+class LegacyPrinter {
+public:
+    void print(const OString& data) { message += data; }
+    void print(uint8_t data, Format format) {
+        std::stringstream oss;
+        if (format == Format::Decimal)
+            oss << static_cast<uint16_t>(data);
+        else
+            oss << std::setfill('0') << std::setw(2) << std::hex << static_cast<uint16_t>(data);
+        print(oss.str().c_str());
+    }
+    void print(uint16_t data, Format /*format*/) {
+        std::stringstream oss;
+        oss << std::setfill('0') << std::setw(4) << std::hex << data;
+        print(oss.str().c_str());
+    }
+    void print(double data, int digit) {
+        std::stringstream oss;
+        oss << std::fixed << std::setprecision(digit) << data;
+        print(oss.str().c_str());
+    }
+    void printlnBool(bool value) { print(value ? "true\n" : "false\n"); }
+    OString message;
+};
+
+/**
+ * @brief Build a message similar to a RunCam info reply
+ * @tparam Printer The printer type
+ * @param printer The printer to fill
+ */
+template<class Printer>
+void fillInfo(Printer& printer) {
+    printer.print(OString("RunCam Protocol version: ............... "));
+    printer.print(static_cast<uint8_t>(4), Format::Decimal);
+    printer.print(OString("\nRunCam GetInfo feature: "));
+    printer.print(static_cast<uint16_t>(0x1f7), Format::Hexadecimal);
+    printer.print(OString("\nRunCam GetInfo message: "));
+    for (uint8_t i = 0; i < 3; ++i) {
+        printer.print(static_cast<uint8_t>(i * 37), Format::Hexadecimal);
+        printer.print(OString(" "));
+    }
+    printer.print(OString("\nTemperature: "));
+    printer.print(36.6, 2);
+    for (uint8_t i = 0; i < 9; ++i) {
+        printer.print(OString("\nRunCam Feature: ...... "));
+        printer.printlnBool((i % 2) == 0);
+    }
+}
+
+void test_print() {
+    uint64_t start      = micros64();
+    size_t legacyLength = 0;
+    for (uint64_t i = 0; i < benchLoops; ++i) {
+        LegacyPrinter printer;
+        fillInfo(printer);
+        legacyLength = printer.message.size();
+    }
+    uint64_t legacy = micros64() - start;
+    start           = micros64();
+    size_t newLength = 0;
+    for (uint64_t i = 0; i < benchLoops; ++i) {
+        Message msg;
+        fillInfo(msg);
+        newLength = msg.getMessage().size();
+    }
+    uint64_t current = micros64() - start;
+    TEST_ASSERT_EQUAL(legacyLength, newLength);
+    char buffer[120];
+    snprintf(buffer, 120, "message print: stringstream %.3f us/msg, payload %.3f us/msg",
+             static_cast<double>(legacy) / benchLoops, static_cast<double>(current) / benchLoops);
+    TEST_MESSAGE(buffer);
+}
+
+void test_all() {
+    UNITY_BEGIN();
+    RUN_TEST(test_print);
+    UNITY_END();
+}
@@ -0,0 +1,136 @@
+/**
+ * @file test_bench_path.cpp
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+#include "../test_base.h"
+#include "data/DataUtils.h"
+#include "fs/Path.h"
+#include <cstdio>
+
+using namespace obd::fs;
+using namespace obd;
+
+/// Number of passes over the benchmark's paths
+constexpr int benchPasses = 20000;
+/// The working directory of the benchmark
+const OString benchCwd{"/config/drivers"};
+/// Relative paths made absolute by the benchmark
+const char* const benchPaths[] = {
+        "clock.cfg",
+        "../title.odb",
+        "./net/wifi.cfg",
+        "../../logs/./boot.log",
+        "cam/../cam/runcam.cfg",
+        "a/b/c/../../d.txt",
+};
+
+/**
+ * @brief Compact a path the way Path did before: split in a vector, filter, then merge
+ * @param path The path to compact
+ */
+void splitCompact(OString& path) {
+    if (path == "/")
+        return;
+    bool absolute = path[0] == '/';
+    auto items    = data::split(path, "/");
+    std::vector<OString> filtered;
+    std::vector<OString>::size_type min_id = 0;
+    bool increment                         = !absolute;
+    for (auto& item : items) {
+        if (item == "." && !(increment && filtered.empty()))
+            continue;
+        if (item == ".." && !increment) {
+            if (filtered.size() > min_id)
+                filtered.pop_back();
+            continue;
+        }
+        if (increment) {
+            if (item == ".." || item == ".") {
+                ++min_id;
+            } else {
+                increment = false;
+            }
+        }
+        filtered.push_back(item);
+    }
+    path = absolute ? "/" : "";
+    path += data::merge(filtered, "/");
+    if (path.empty())
+        path = ".";
+}
+
+/**
+ * @brief Make a path absolute the way Path did before
+ * @param path The path
+ * @param current The current path
+ */
+void splitMakeAbsolute(OString& path, const OString& current) {
+    if (path[0] == '/')
+        return;
+    path = current + "/" + path;
+    splitCompact(path);
+}
+
+/**
+ * @brief Print the throughput of a benchmark
+ * @param name The benchmark's name
+ * @param count The amount of paths treated
+ * @param elapsed The time in microseconds
+ */
+void report(const char* name, size_t count, uint64_t elapsed) {
+    char buffer[100];
+    snprintf(buffer, 100, "%s: %.2f Mpath/s", name, static_cast<double>(count) / static_cast<double>(elapsed > 0 ? elapsed : 1));
+    TEST_MESSAGE(buffer);
+}
+
+void test_same_results() {
+    for (const auto* item : benchPaths) {
+        OString reference{item};
+        splitMakeAbsolute(reference, benchCwd);
+        Path path{OString{item}};
+        path.makeAbsolute(Path{OString{benchCwd}});
+        TEST_ASSERT_EQUAL_STRING(reference.c_str(), path.toString().c_str());
+    }
+}
+
+void test_makeAbsolute() {
+    const Path cwd{OString{benchCwd}};
+    size_t count = 0;
+    size_t bytes = 0;
+
+    uint64_t start = micros64();
+    for (int pass = 0; pass < benchPasses; ++pass) {
+        for (const auto* item : benchPaths) {
+            OString path{item};
+            splitMakeAbsolute(path, benchCwd);
+            bytes += path.size();
+            ++count;
+        }
+    }
+    report("split and merge", count, micros64() - start);
+    size_t oldBytes = bytes;
+    count           = 0;
+    bytes           = 0;
+
+    start = micros64();
+    for (int pass = 0; pass < benchPasses; ++pass) {
+        for (const auto* item : benchPaths) {
+            Path path{OString{item}};
+            path.makeAbsolute(cwd);
+            bytes += path.toString().size();
+            ++count;
+        }
+    }
+    report("in place       ", count, micros64() - start);
+    TEST_ASSERT_EQUAL(oldBytes, bytes);
+}
+
+void test_all() {
+    UNITY_BEGIN();
+    RUN_TEST(test_same_results);
+    RUN_TEST(test_makeAbsolute);
+    UNITY_END();
+}
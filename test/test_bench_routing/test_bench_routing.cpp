@@ -0,0 +1,75 @@
+/**
+ * @file test_bench_routing.cpp
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+#include "../test_base.h"
+#include "core/driver/Manager.h"
+#include "core/driver/Messenger.h"
+#include <cstdio>
+#include <utility>
+
+using namespace obd::core::driver;
+
+/// Amount of message routed per benchmark
+constexpr uint64_t benchMessages = 100000;
+
+/**
+ * @brief Node type only used to get distinct type ids
+ * @tparam I Node index
+ */
+template<size_t I>
+class BenchNode : public Node {
+public:
+    explicit BenchNode(std::shared_ptr<Messenger> msg) :
+        Node{std::move(msg)} {
+        // never drained: keep the queue rolling
+        setQueuePolicy(obd::data::OverflowPolicy::DropOldest);
+    }
+};
+
+template<size_t... I>
+void addBenchNodes(const std::shared_ptr<Manager>& mng, const std::shared_ptr<Messenger>& msg, std::index_sequence<I...>) {
+    (mng->addNode(std::make_shared<BenchNode<I>>(msg)), ...);
+}
+
+template<size_t N>
+void benchRouting() {
+    auto mng = std::make_shared<Manager>();
+    auto msg = std::make_shared<Messenger>(mng);
+    addBenchNodes(mng, msg, std::make_index_sequence<N>{});
+    TEST_ASSERT_EQUAL(N, mng->size());
+    msg->init();
+    mng->init();
+    std::vector<NodeId> ids;
+    for (const auto& node : *mng)
+        ids.push_back(node->id());
+    uint64_t start = micros64();
+    for (uint64_t i = 0; i < benchMessages; ++i) {
+        msg->pushMessage(Message{0, ids[i % N], "bench"});
+        if (msg->size() >= 10)
+            msg->update();
+    }
+    msg->update();
+    uint64_t elapsed = micros64() - start;
+    TEST_ASSERT_EQUAL(benchMessages, msg->stats().sentMessages);
+    char buffer[100];
+    snprintf(buffer, 100, "routing %2zu nodes: %.0f messages/s", N, benchMessages * 1e6 / static_cast<double>(elapsed > 0 ? elapsed : 1));
+    TEST_MESSAGE(buffer);
+}
+
+void test_routing4() { benchRouting<4>(); }
+
+void test_routing16() { benchRouting<16>(); }
+
+void test_routing64() { benchRouting<64>(); }
+
+void test_all() {
+    UNITY_BEGIN();
+    RUN_TEST(test_routing4);
+    RUN_TEST(test_routing16);
+    RUN_TEST(test_routing64);
+    UNITY_END();
+}
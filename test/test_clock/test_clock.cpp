@@ -5,7 +5,9 @@
  * Copyright © 2022 All rights reserved.
  * All modification must get authorization from the author.
  */
-#include "../test_base.h"
+#include "../test_helper.h"
+#include "core/timer/VirtualClock.h"
+#include "fs/FileSystem.h"
 #include "time/Clock.h"
 
 void test_bad_init(){
@@ -22,13 +24,26 @@ void test_bad_init(){
     TEST_ASSERT(badClock2.initialized())
 }
 
+void test_no_filesystem(){
+    auto mng = std::make_shared<obd::core::driver::Manager>();
+    auto messenger = std::make_shared<obd::core::driver::Messenger>(mng);
+    auto clk = std::make_shared<obd::time::Clock>(messenger);
+    mng->addNode(clk);
+    mng->init();
+    // the file system is optional
+    TEST_ASSERT(clk->initState() == obd::core::driver::InitState::Done)
+    TEST_ASSERT(clk->initialized())
+}
+
 void test_update(){
     auto clk =  baseSys.getNode<obd::time::Clock>();
     auto hdd = baseSys.getNode<obd::fs::FileSystem>();
     obd::fs::Path time_save{obd::config::tsSave};
     TEST_ASSERT(hdd->mkdir(time_save.parent(),true,true))
-    clk->accelerateTime(obd::config::saveInterval + 1);// try to provoque a time save
-    clk->update();
+    obd::core::timer::VirtualClock::enable();
+    obd::core::timer::VirtualClock::advance(obd::config::saveInterval + 1);// try to provoque a time save
+    baseSys.update();
+    obd::core::timer::VirtualClock::disable();
     TEST_ASSERT(hdd->exists(obd::fs::Path{obd::config::tsSave}))
 }
 
@@ -54,8 +69,18 @@ void test_all() {
     UNITY_BEGIN();
     // tests one update
     RUN_TEST(test_bad_init);
+    RUN_TEST(test_no_filesystem);
     RUN_TEST(test_update);
     RUN_TEST(test_commands);
     RUN_TEST(test_config);
     UNITY_END();
-}
\ No newline at end of file
+}
+void setup() {
+    // the clock and its file system are not base nodes
+    baseSys.addNode<obd::fs::FileSystem>();
+    baseSys.addNode<obd::time::Clock>();
+    baseSys.init();
+    test_all();
+}
+
+void loop() {}
@@ -6,7 +6,12 @@
  * All modification must get authorization from the author.
  */
 #include "../test_base.h"
+#include "data/Arena.h"
+#include "data/DataUtils.h"
+#include "data/RingBuffer.h"
 #include "data/Series.h"
+#include "data/Span.h"
+#include <array>
 
 void test_series() {
     obd::data::Series<float, 10> data;
@@ -32,8 +37,121 @@ void test_series() {
     TEST_ASSERT_EQUAL_FLOAT(8.25, data.variance());
 }
 
+void test_ringBuffer() {
+    using obd::data::OverflowPolicy;
+    using obd::data::PushResult;
+    obd::data::RingBuffer<int, 4> buffer;
+    TEST_ASSERT(buffer.empty())
+    TEST_ASSERT_EQUAL(4, buffer.maxSize());
+    for (int i = 0; i < 4; ++i)
+        TEST_ASSERT(buffer.push(i) == PushResult::Pushed)
+    TEST_ASSERT(buffer.full())
+    // default policy: reject
+    TEST_ASSERT(buffer.push(4) == PushResult::Rejected)
+    TEST_ASSERT_EQUAL(0, buffer.front());
+    buffer.setPolicy(OverflowPolicy::DropNewest);
+    TEST_ASSERT(buffer.push(4) == PushResult::DroppedNewest)
+    TEST_ASSERT_EQUAL(0, buffer.front());
+    buffer.setPolicy(OverflowPolicy::DropOldest);
+    TEST_ASSERT(buffer.push(4) == PushResult::DroppedOldest)
+    TEST_ASSERT_EQUAL(4, buffer.size());
+    TEST_ASSERT_EQUAL(1, buffer.front());
+    // wrap around
+    buffer.pop();
+    buffer.pop();
+    TEST_ASSERT(buffer.push(5) == PushResult::Pushed)
+    TEST_ASSERT_EQUAL(3, buffer.front());
+    buffer.setLimit(2);
+    TEST_ASSERT(buffer.push(6) == PushResult::DroppedOldest)
+    TEST_ASSERT_EQUAL(4, buffer.front());
+    buffer.clear();
+    TEST_ASSERT(buffer.empty())
+    buffer.pop();
+    TEST_ASSERT(buffer.empty())
+    buffer.setLimit(0);
+    TEST_ASSERT_EQUAL(4, buffer.getLimit());
+}
+
+void test_ringQueue() {
+    using obd::data::OverflowPolicy;
+    using obd::data::PushResult;
+    obd::data::RingQueue<int> queue;
+    // no storage: nothing fits
+    TEST_ASSERT_EQUAL(0, queue.maxSize());
+    TEST_ASSERT(queue.push(1) == PushResult::Rejected)
+    queue.setPolicy(OverflowPolicy::DropOldest);
+    TEST_ASSERT(queue.push(1) == PushResult::DroppedNewest)
+    TEST_ASSERT(queue.empty())
+    std::array<int, 2> storage{};
+    queue.attach(storage);
+    TEST_ASSERT_EQUAL(2, queue.maxSize());
+    TEST_ASSERT(queue.push(1) == PushResult::Pushed)
+    TEST_ASSERT(queue.push(2) == PushResult::Pushed)
+    TEST_ASSERT(queue.push(3) == PushResult::DroppedOldest)
+    TEST_ASSERT_EQUAL(2, queue.front());
+    TEST_ASSERT_EQUAL(3, queue[1]);
+}
+
+void test_arena() {
+    using namespace obd::data;
+    Arena arena;
+    TEST_ASSERT_NULL(Arena::current());
+    {
+        ArenaScope frame{arena};
+        TEST_ASSERT(Arena::current() == &arena)
+        void* first = arena.allocate(3, 1);
+        void* second = arena.allocate(8, 8);
+        TEST_ASSERT(arena.owns(first))
+        TEST_ASSERT_EQUAL(0, reinterpret_cast<uintptr_t>(second) % 8);
+        TEST_ASSERT_EQUAL(16, arena.used());
+        TEST_ASSERT_NULL(arena.allocate(Arena::capacity()));
+        TEST_ASSERT_EQUAL(1, arena.overflows());
+        // components as views, the list in the arena
+        auto items = split("/dev/time/", "/", Arena::current());
+        TEST_ASSERT(arena.owns(items.data()))
+        TEST_ASSERT_EQUAL(3, items.size());
+        TEST_ASSERT(items[1] == "time")
+        TEST_ASSERT(items[2].empty())
+        auto merged = merge(items, "::", Arena::current());
+        TEST_ASSERT_EQUAL_STRING("dev::time::", merged.c_str());
+        // larger than the arena: from the heap
+        ArenaString large(Arena::capacity(), 'x', ArenaAllocator<char>{&arena});
+        TEST_ASSERT_FALSE(arena.owns(large.data()))
+    }
+    TEST_ASSERT_NULL(Arena::current());
+    TEST_ASSERT_EQUAL(0, arena.used());
+    TEST_ASSERT(arena.peak() > 16)
+    // no arena: the heap
+    auto items = split("a.b", ".", nullptr);
+    TEST_ASSERT_EQUAL(2, items.size());
+}
+
+void test_span() {
+    std::array<uint8_t, 4> values{1, 2, 3, 4};
+    obd::data::Span<uint8_t> view{values};
+    TEST_ASSERT_EQUAL(4, view.size());
+    view[0] = 5;
+    TEST_ASSERT_EQUAL(5, values[0]);
+    obd::data::Span<const uint8_t> constView = view;
+    auto part                                = constView.subspan(1, 2);
+    TEST_ASSERT_EQUAL(2, part.size());
+    TEST_ASSERT_EQUAL(2, part[0]);
+    TEST_ASSERT(constView.subspan(3, 10).size() == 1)
+    TEST_ASSERT(constView.subspan(10).empty())
+    uint16_t words[3]{};
+    TEST_ASSERT_EQUAL(6, obd::data::Span<uint16_t>{words}.size_bytes());
+    int sum = 0;
+    for (auto value : part)
+        sum += value;
+    TEST_ASSERT_EQUAL(5, sum);
+}
+
 void test_all() {
     UNITY_BEGIN();
     RUN_TEST(test_series);
+    RUN_TEST(test_ringBuffer);
+    RUN_TEST(test_ringQueue);
+    RUN_TEST(test_arena);
+    RUN_TEST(test_span);
     UNITY_END();
 }
@@ -7,6 +7,8 @@
  */
 #include "../test_base.h"
 #include "core/driver/Manager.h"
+#include "core/driver/Messenger.h"
+#include "core/timer/VirtualClock.h"
 #include <iostream>
 #include <utility>
 
@@ -47,9 +49,402 @@ void test_getDriver() {
     TEST_ASSERT_NOT_NULL(mng.getDriver<OtherNode>())
 }
 
+void test_routes() {
+    Manager mng;
+    TEST_ASSERT_FALSE(mng.addNode(nullptr))
+    auto node = std::make_shared<Node>(nullptr);
+    mng.addNode(node);
+    TEST_ASSERT(mng.route(node->id()) == node.get())
+    TEST_ASSERT_NULL(mng.route(0))
+    TEST_ASSERT_EQUAL(1, mng.broadcastList().size());
+    TEST_ASSERT_EQUAL(1, mng.categoryList(Category::None).size());
+    TEST_ASSERT(mng.categoryList(Category::Console).empty())
+}
+
+void test_ids() {
+    Manager mng;
+    auto node = std::make_shared<Node>(nullptr);
+    TEST_ASSERT_EQUAL(unknownId, node->id());
+    mng.addNode(node);
+    TEST_ASSERT_EQUAL(1, node->id());
+    TEST_ASSERT_EQUAL(1, mng.idOf("Node"));
+    TEST_ASSERT_EQUAL(1, mng.idOf(node->type()));
+    TEST_ASSERT_EQUAL(unknownId, mng.idOf("toto"));
+    TEST_ASSERT_EQUAL(unknownId, mng.idOf(size_t{0}));
+    TEST_ASSERT_EQUAL_STRING("Node", mng.nameOf(1).c_str());
+    TEST_ASSERT_EQUAL_STRING("Unknown", mng.nameOf(2).c_str());
+    TEST_ASSERT(mng.getNodeById(1) == node)
+    TEST_ASSERT_NULL(mng.getNodeById(broadcastId))
+}
+
+/**
+ * @brief Node counting its runs
+ */
+class SlowNode : public Node {
+public:
+    explicit SlowNode(std::shared_ptr<Messenger> msg) :
+        Node{std::move(msg)} {
+        setSchedule(20000, 100);
+    }
+    /// Busy time of a run in microseconds
+    unsigned int workTime = 0;
+    /// Amount of runs
+    size_t counter = 0;
+
+protected:
+    void preTreatment() override {
+        ++counter;
+        delayMicroseconds(workTime);
+    }
+};
+
+/**
+ * @brief Node running every frame
+ */
+class FastNode : public Node {
+public:
+    explicit FastNode(std::shared_ptr<Messenger> msg) :
+        Node{std::move(msg)} {
+        setSchedule(0, 3000);
+    }
+};
+
+void test_schedule() {
+    std::shared_ptr<Manager> mng   = std::make_shared<Manager>();
+    std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(mng);
+    auto slow                      = std::make_shared<SlowNode>(msg);
+    auto fast                      = std::make_shared<FastNode>(msg);
+    mng->addNode(slow);
+    mng->addNode(fast);
+    mng->init();
+    mng->update();
+    mng->update();
+    TEST_ASSERT_EQUAL(1, slow->counter);
+    TEST_ASSERT_EQUAL(2, fast->schedule().runs);
+    // waiting messages wake the node before its deadline
+    TEST_ASSERT(slow->pushMessage(Message{0, slow->id(), "info", Message::MessageType::Command}))
+    mng->update();
+    TEST_ASSERT_EQUAL(2, slow->counter);
+    mng->update();
+    TEST_ASSERT_EQUAL(2, slow->counter);
+    delay(21);
+    mng->update();
+    TEST_ASSERT_EQUAL(3, slow->counter);
+    TEST_ASSERT_FALSE(slow->schedule().overrun)
+    // a run longer than the budget is flagged
+    slow->workTime = 300;
+    delay(21);
+    mng->update();
+    TEST_ASSERT_EQUAL(4, slow->counter);
+    TEST_ASSERT(slow->schedule().overrun)
+    TEST_ASSERT_EQUAL(1, slow->schedule().overruns);
+    TEST_ASSERT(slow->schedule().lastTime >= 300)
+    TEST_ASSERT(slow->schedule().maxTime >= 300)
+    TEST_ASSERT_EQUAL(0, fast->schedule().overruns);
+}
+
+void test_frameBudget() {
+    std::shared_ptr<Manager> mng   = std::make_shared<Manager>();
+    std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(mng);
+    auto slow                      = std::make_shared<SlowNode>(msg);
+    auto fast                      = std::make_shared<FastNode>(msg);
+    mng->addNode(slow);
+    mng->addNode(fast);
+    mng->init();
+    mng->setFrameBudget(2000);
+    TEST_ASSERT_EQUAL(2000, mng->frameBudget());
+    slow->workTime = 1500;
+    // same deadline: the first node runs, the budget of the other does not fit
+    mng->update();
+    TEST_ASSERT_EQUAL(1, slow->schedule().runs);
+    TEST_ASSERT_EQUAL(0, fast->schedule().runs);
+    TEST_ASSERT_EQUAL(1, fast->schedule().deferred);
+    // the postponed node has now the earliest deadline
+    mng->update();
+    TEST_ASSERT_EQUAL(1, fast->schedule().runs);
+}
+
+/**
+ * @brief Node waiting for messages or input
+ */
+class EventNode : public Node {
+public:
+    explicit EventNode(std::shared_ptr<Messenger> msg) :
+        Node{std::move(msg)} {
+        setWakeups(Wakeup::Message | Wakeup::Io);
+    }
+    /// Simulated input
+    bool input = false;
+    /// Stop waking up
+    void sleep() { setWakeups(Wakeup::None); }
+
+protected:
+    bool ioReady() override { return input; }
+};
+
+void test_wakeups() {
+    std::shared_ptr<Manager> mng   = std::make_shared<Manager>();
+    std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(mng);
+    auto event                     = std::make_shared<EventNode>(msg);
+    auto slow                      = std::make_shared<SlowNode>(msg);
+    mng->addNode(event);
+    mng->addNode(slow);
+    mng->init();
+    mng->update();
+    TEST_ASSERT_EQUAL(0, event->schedule().runs);
+    TEST_ASSERT_EQUAL(1, slow->schedule().runs);
+    // nobody ready: sleep until the slow node's deadline, at most the input poll period
+    uint64_t idle = mng->idleTime();
+    TEST_ASSERT(idle > 0)
+    TEST_ASSERT(idle <= obd::config::ioPollPeriod)
+    // message arrival
+    TEST_ASSERT(event->pushMessage(Message{0, event->id(), "info", Message::MessageType::Command}))
+    TEST_ASSERT_EQUAL(0, mng->idleTime());
+    mng->update();
+    TEST_ASSERT_EQUAL(1, event->schedule().runs);
+    mng->update();
+    TEST_ASSERT_EQUAL(1, event->schedule().runs);
+    // input readiness
+    event->input = true;
+    mng->update();
+    TEST_ASSERT_EQUAL(2, event->schedule().runs);
+    event->input = false;
+    // notification (from an interrupt)
+    event->notify();
+    TEST_ASSERT_EQUAL(0, mng->idleTime());
+    mng->update();
+    TEST_ASSERT_EQUAL(3, event->schedule().runs);
+    mng->update();
+    TEST_ASSERT_EQUAL(3, event->schedule().runs);
+    TEST_ASSERT_EQUAL(1, slow->schedule().runs);
+    // timer expiry
+    event->sleep();
+    TEST_ASSERT(mng->idleTime() > obd::config::ioPollPeriod)
+    delay(21);
+    TEST_ASSERT_EQUAL(0, mng->idleTime());
+    mng->update();
+    TEST_ASSERT_EQUAL(2, slow->schedule().runs);
+}
+
+/// Ids of the boot nodes, in init order
+std::vector<int> bootLog;
+
+/**
+ * @brief Node logging its init, with dependencies
+ * @tparam N The node's number
+ */
+template<int N>
+class BootNode : public Node {
+public:
+    explicit BootNode(std::shared_ptr<Messenger> msg) :
+        Node{std::move(msg)} {
+        setWakeups(Wakeup::Message);
+    }
+    /// Declare a dependency
+    template<class T>
+    void need() { dependsOn<T>(); }
+    /// Declare an optional dependency
+    template<class T>
+    void use() { dependsOnOptional<T>(); }
+    /// Make the init fail
+    bool broken = false;
+    /// Number of nodes linked
+    int links = 0;
+    void init() override {
+        Node::init();
+        _initialized = !broken;
+        bootLog.push_back(N);
+    }
+    bool linkNode(const std::shared_ptr<Node>& /*node*/) override {
+        ++links;
+        return true;
+    }
+};
+
+void test_dependencies() {
+    bootLog.clear();
+    std::shared_ptr<Manager> mng   = std::make_shared<Manager>();
+    std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(mng);
+    auto first                     = std::make_shared<BootNode<1>>(msg);
+    auto second                    = std::make_shared<BootNode<2>>(msg);
+    auto third                     = std::make_shared<BootNode<3>>(msg);
+    auto fourth                    = std::make_shared<BootNode<4>>(msg);
+    // 1 -> 3 -> 2, 4 independent
+    first->need<BootNode<3>>();
+    third->need<BootNode<2>>();
+    mng->addNode(first);
+    mng->addNode(second);
+    mng->addNode(third);
+    mng->addNode(fourth);
+    mng->init();
+    TEST_ASSERT_EQUAL(4, bootLog.size());
+    TEST_ASSERT_EQUAL(2, bootLog[0]);
+    TEST_ASSERT_EQUAL(4, bootLog[1]);
+    TEST_ASSERT_EQUAL(3, bootLog[2]);
+    TEST_ASSERT_EQUAL(1, bootLog[3]);
+    TEST_ASSERT_EQUAL(4, mng->initOrder().size());
+    TEST_ASSERT(first->initState() == InitState::Done)
+    TEST_ASSERT(fourth->initState() == InitState::Done)
+    // linked both ways
+    TEST_ASSERT_EQUAL(1, first->links);
+    TEST_ASSERT_EQUAL(2, third->links);
+    TEST_ASSERT_EQUAL(1, second->links);
+    TEST_ASSERT_EQUAL(0, fourth->links);
+}
+
+void test_dependencyErrors() {
+    bootLog.clear();
+    std::shared_ptr<Manager> mng   = std::make_shared<Manager>();
+    std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(mng);
+    auto first                     = std::make_shared<BootNode<1>>(msg);
+    auto second                    = std::make_shared<BootNode<2>>(msg);
+    auto third                     = std::make_shared<BootNode<3>>(msg);
+    auto fourth                    = std::make_shared<BootNode<4>>(msg);
+    auto fifth                     = std::make_shared<BootNode<5>>(msg);
+    // cycle 1 <-> 2, 3 needs an absent node, 5 needs the failing 4
+    first->need<BootNode<2>>();
+    second->need<BootNode<1>>();
+    third->need<BootNode<6>>();
+    fifth->need<BootNode<4>>();
+    fourth->broken = true;
+    mng->addNode(first);
+    mng->addNode(second);
+    mng->addNode(third);
+    mng->addNode(fourth);
+    mng->addNode(fifth);
+    mng->init();
+    TEST_ASSERT_EQUAL(1, bootLog.size());
+    TEST_ASSERT_EQUAL(4, bootLog[0]);
+    TEST_ASSERT_EQUAL(3, mng->initOrder().size());
+    TEST_ASSERT(first->initState() == InitState::Cycle)
+    TEST_ASSERT(second->initState() == InitState::Cycle)
+    TEST_ASSERT(third->initState() == InitState::MissingDependency)
+    TEST_ASSERT(fourth->initState() == InitState::Failed)
+    TEST_ASSERT(fifth->initState() == InitState::MissingDependency)
+    TEST_ASSERT_FALSE(fifth->initialized())
+    // the errors are reported to the console
+    TEST_ASSERT_EQUAL(4, msg->size());
+}
+
+void test_optionalDependencies() {
+    bootLog.clear();
+    std::shared_ptr<Manager> mng   = std::make_shared<Manager>();
+    std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(mng);
+    auto first                     = std::make_shared<BootNode<1>>(msg);
+    auto second                    = std::make_shared<BootNode<2>>(msg);
+    auto third                     = std::make_shared<BootNode<3>>(msg);
+    auto fourth                    = std::make_shared<BootNode<4>>(msg);
+    auto fifth                     = std::make_shared<BootNode<5>>(msg);
+    // 1 uses 2, 3 uses an absent node, 4 needs 5 which uses 4
+    first->use<BootNode<2>>();
+    third->use<BootNode<6>>();
+    fourth->need<BootNode<5>>();
+    fifth->use<BootNode<4>>();
+    mng->addNode(first);
+    mng->addNode(second);
+    mng->addNode(third);
+    mng->addNode(fourth);
+    mng->addNode(fifth);
+    mng->init();
+    // the optional dependencies order the init, but never block it
+    TEST_ASSERT_EQUAL(5, bootLog.size());
+    TEST_ASSERT_EQUAL(2, bootLog[0]);
+    TEST_ASSERT_EQUAL(3, bootLog[1]);
+    TEST_ASSERT_EQUAL(1, bootLog[2]);
+    TEST_ASSERT_EQUAL(5, bootLog[3]);
+    TEST_ASSERT_EQUAL(4, bootLog[4]);
+    TEST_ASSERT(third->initState() == InitState::Done)
+    TEST_ASSERT(fifth->initState() == InitState::Done)
+    // linked once, both ways
+    TEST_ASSERT_EQUAL(1, first->links);
+    TEST_ASSERT_EQUAL(1, second->links);
+    TEST_ASSERT_EQUAL(0, third->links);
+    TEST_ASSERT_EQUAL(1, fourth->links);
+    TEST_ASSERT_EQUAL(1, fifth->links);
+    // a failed optional dependency is not linked
+    bootLog.clear();
+    std::shared_ptr<Manager> mng2   = std::make_shared<Manager>();
+    std::shared_ptr<Messenger> msg2 = std::make_shared<Messenger>(mng2);
+    auto user                       = std::make_shared<BootNode<1>>(msg2);
+    auto broken                     = std::make_shared<BootNode<2>>(msg2);
+    user->use<BootNode<2>>();
+    broken->broken = true;
+    mng2->addNode(user);
+    mng2->addNode(broken);
+    mng2->init();
+    TEST_ASSERT(user->initState() == InitState::Done)
+    TEST_ASSERT(broken->initState() == InitState::Failed)
+    TEST_ASSERT_EQUAL(0, user->links);
+}
+
+/**
+ * @brief Node whose init takes three steps, 10ms apart
+ */
+class StepNode : public Node {
+public:
+    explicit StepNode(std::shared_ptr<Messenger> msg) :
+        Node{std::move(msg)} {}
+    /// Number of steps done
+    int steps = 0;
+    InitStatus initStep() override {
+        if (++steps < 3)
+            return retryIn(10000);
+        init();
+        return InitStatus::Done;
+    }
+};
+
+void test_initSteps() {
+    using obd::core::timer::VirtualClock;
+    VirtualClock::enable();
+    bootLog.clear();
+    std::shared_ptr<Manager> mng   = std::make_shared<Manager>();
+    std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(mng);
+    auto step                      = std::make_shared<StepNode>(msg);
+    auto after                     = std::make_shared<BootNode<1>>(msg);
+    auto other                     = std::make_shared<BootNode<2>>(msg);
+    after->need<StepNode>();
+    mng->addNode(after);
+    mng->addNode(step);
+    mng->addNode(other);
+    mng->init();
+    // the independent node is ready at once, the others wait
+    TEST_ASSERT(mng->booting())
+    TEST_ASSERT_EQUAL(1, step->steps);
+    TEST_ASSERT(step->initState() == InitState::Pending)
+    TEST_ASSERT(after->initState() == InitState::Waiting)
+    TEST_ASSERT(other->initState() == InitState::Done)
+    TEST_ASSERT_EQUAL(1, bootLog.size());
+    TEST_ASSERT_EQUAL(10000, mng->idleTime());
+    // not before the asked delay
+    mng->update();
+    TEST_ASSERT_EQUAL(1, step->steps);
+    VirtualClock::advance(10000);
+    mng->update();
+    TEST_ASSERT_EQUAL(2, step->steps);
+    VirtualClock::advance(10000);
+    mng->update();
+    // the dependent starts in the frame its dependency ends
+    TEST_ASSERT_EQUAL(3, step->steps);
+    TEST_ASSERT(step->initialized())
+    TEST_ASSERT(after->initState() == InitState::Done)
+    TEST_ASSERT_EQUAL(1, after->links);
+    TEST_ASSERT_FALSE(mng->booting())
+    VirtualClock::disable();
+}
+
 void test_all() {
     UNITY_BEGIN();
     RUN_TEST(test_getNode);
     RUN_TEST(test_getDriver);
+    RUN_TEST(test_routes);
+    RUN_TEST(test_ids);
+    RUN_TEST(test_schedule);
+    RUN_TEST(test_frameBudget);
+    RUN_TEST(test_wakeups);
+    RUN_TEST(test_dependencies);
+    RUN_TEST(test_dependencyErrors);
+    RUN_TEST(test_optionalDependencies);
+    RUN_TEST(test_initSteps);
     UNITY_END();
 }
@@ -29,14 +29,14 @@ void test_managed() {
     node->init();
     TEST_ASSERT(node->initialized());
     // push several messages
-    msg->pushMessage(Message{0, 1, "yo"});
-    msg->pushMessage(Message{0, node->type(), "yo", Message::MessageType::Command});
-    msg->pushMessage(Message{0, node->type(), "yo", Message::MessageType::Command});
-    msg->pushMessage(Message{0, node->type(), "info", Message::MessageType::Command});
-    msg->pushMessage(Message{0, node->type(), "yo1"});
-    msg->pushMessage(Message{0, node->type(), "yo2"});
-    msg->pushMessage(Message{0, node->type(), "yo3"});
-    msg->pushMessage(Message{0, node->type(), "yo4"});
+    msg->pushMessage(Message{0, 42, "yo"});
+    msg->pushMessage(Message{0, node->id(), "yo", Message::MessageType::Command});
+    msg->pushMessage(Message{0, node->id(), "yo", Message::MessageType::Command});
+    msg->pushMessage(Message{0, node->id(), "info", Message::MessageType::Command});
+    msg->pushMessage(Message{0, node->id(), "yo1"});
+    msg->pushMessage(Message{0, node->id(), "yo2"});
+    msg->pushMessage(Message{0, node->id(), "yo3"});
+    msg->pushMessage(Message{0, node->id(), "yo4"});
     msg->pushMessage(Message{0, 0, "yo2", Message::MessageType::Command});
     msg->pushMessage(Message{0, 0, "yo3"});
     msg->pushMessage(Message{0, 0, "yo3"});
@@ -49,10 +49,345 @@ void test_managed() {
     msg->update();
     TEST_ASSERT_EQUAL(10, node->messageSize());
     node->update();
-    TEST_ASSERT_EQUAL(5, msg->size());
+    // the 3 'Unknown Command' warnings have been handled (and dropped: no console) in the same frame
+    TEST_ASSERT_EQUAL(2, msg->size());
     TEST_ASSERT_EQUAL(19, msg->stats().receivedMessages);
     TEST_ASSERT_EQUAL(10, msg->stats().sentMessages);
-    TEST_ASSERT_EQUAL(4, msg->stats().droppedMessage);
+    TEST_ASSERT_EQUAL(7, msg->stats().droppedMessage);
+}
+
+void test_lanes() {
+    std::shared_ptr<Manager> mng   = std::make_shared<Manager>();
+    std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(mng);
+    std::shared_ptr<Node> node     = std::make_shared<Node>(msg);
+    mng->addNode(node);
+    node->init();
+    // a command behind a burst of console messages
+    for (uint8_t i = 0; i < 12; ++i)
+        msg->pushMessage(Message{0, node->id(), "chat"});
+    msg->pushMessage(Message{0, node->id(), "info", Message::MessageType::Command});
+    TEST_ASSERT_EQUAL(1, msg->size(Messenger::Lane::Control));
+    TEST_ASSERT_EQUAL(12, msg->size(Messenger::Lane::Background));
+    msg->update();
+    TEST_ASSERT_EQUAL(0, msg->size(Messenger::Lane::Control));
+    TEST_ASSERT_EQUAL(3, msg->size(Messenger::Lane::Background));
+    TEST_ASSERT_EQUAL(1, msg->stats().laneLatency[static_cast<size_t>(Messenger::Lane::Control)].count);
+    TEST_ASSERT_EQUAL(9, msg->stats().laneLatency[static_cast<size_t>(Messenger::Lane::Background)].count);
+    // the background lane still drains under a flood of errors
+    while (node->messageSize() > 0) node->update();
+    msg->update();
+    while (node->messageSize() > 0) node->update();
+    for (uint8_t i = 0; i < 12; ++i)
+        msg->pushMessage(Message{0, node->id(), "flood", Message::MessageType::Error});
+    msg->pushMessage(Message{0, node->id(), "chat"});
+    msg->update();
+    TEST_ASSERT_EQUAL(0, msg->size(Messenger::Lane::Background));
+    TEST_ASSERT_EQUAL(3, msg->size(Messenger::Lane::Critical));
+}
+
+/**
+ * @brief Node with a tiny queue
+ */
+class SmallNode : public Node {
+public:
+    explicit SmallNode(std::shared_ptr<Messenger> msg) :
+        Node{std::move(msg)} {
+        setQueuePolicy(obd::data::OverflowPolicy::Reject, 2);
+    }
+    /**
+     * @brief Look at a queued message
+     * @param idx Rank in the queue
+     * @return The message
+     */
+    const Message& queued(size_t idx) { return getMessages()[idx]; }
+};
+
+void test_backpressure() {
+    std::shared_ptr<Manager> mng   = std::make_shared<Manager>();
+    std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(mng);
+    std::shared_ptr<Node> node     = std::make_shared<SmallNode>(msg);
+    mng->addNode(node);
+    node->init();
+    node->setDeliveryAttempts(2);
+    // direct push tells the sender the node is saturated
+    TEST_ASSERT(node->pushMessage(Message{0, node->id(), "a"}))
+    TEST_ASSERT(node->pushMessage(Message{0, node->id(), "b"}))
+    TEST_ASSERT_EQUAL(Delivery::Status::Saturated, node->pushMessage(Message{0, node->id(), "c"}).status());
+    TEST_ASSERT_EQUAL(Delivery::Status::Refused, node->pushMessage(Message{0, node->id(), "bob", Message::MessageType::Command}).status());
+    node->update();
+    msg->update();
+    // the 'Unknown Command' warning found no console
+    TEST_ASSERT_EQUAL(1, msg->deadLetters().size());
+    TEST_ASSERT_EQUAL(Delivery::Status::Unreachable, msg->deadLetters()[0].reason);
+    msg->clearDeadLetters();
+    // through the messenger: the third message waits for the next frame
+    msg->pushMessage(Message{0, node->id(), "1"});
+    msg->pushMessage(Message{0, node->id(), "2"});
+    msg->pushMessage(Message{0, node->id(), "3"});
+    msg->update();
+    TEST_ASSERT_EQUAL(1, msg->size());
+    TEST_ASSERT_EQUAL(1, msg->stats().retriedMessages);
+    node->update();
+    msg->update();
+    TEST_ASSERT_EQUAL(0, msg->size());
+    TEST_ASSERT_EQUAL(0, msg->deadLetters().size());
+    // the node does not drain: give up after 2 frames
+    msg->pushMessage(Message{0, node->id(), "4"});
+    msg->update();
+    msg->pushMessage(Message{0, node->id(), "5"});
+    msg->update();
+    TEST_ASSERT_EQUAL(1, msg->size());
+    msg->update();
+    TEST_ASSERT_EQUAL(0, msg->size());
+    TEST_ASSERT_EQUAL(1, msg->deadLetters().size());
+    TEST_ASSERT_EQUAL(Delivery::Status::Saturated, msg->deadLetters()[0].reason);
+    TEST_ASSERT_EQUAL_STRING("5", msg->deadLetters()[0].message.getMessage().c_str());
+    // no such node
+    msg->pushMessage(Message{0, 42, "lost"});
+    msg->update();
+    TEST_ASSERT_EQUAL(2, msg->deadLetters().size());
+    TEST_ASSERT_EQUAL(Delivery::Status::Unreachable, msg->deadLetters()[1].reason);
+    msg->clearDeadLetters();
+    TEST_ASSERT_EQUAL(0, msg->deadLetters().size());
+}
+
+/**
+ * @brief Node subscribing to the telemetry (one type per instance)
+ */
+template<int Index>
+class Subscriber : public Node {
+public:
+    explicit Subscriber(std::shared_ptr<Messenger> msg) :
+        Node{std::move(msg)} {}
+    /**
+     * @brief Receive the telemetry
+     */
+    void listen() { subscribe(Topic::Telemetry); }
+    /**
+     * @brief Stop receiving the telemetry
+     */
+    void ignore() { unsubscribe(Topic::Telemetry); }
+};
+
+void test_topics() {
+    std::shared_ptr<Manager> mng   = std::make_shared<Manager>();
+    std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(mng);
+    auto first                     = std::make_shared<Subscriber<1>>(msg);
+    auto second                    = std::make_shared<Subscriber<2>>(msg);
+    auto other                     = std::make_shared<Subscriber<3>>(msg);
+    mng->addNode(first);
+    mng->addNode(second);
+    mng->addNode(other);
+    mng->init();
+    first->listen();
+    second->listen();
+    second->listen();
+    TEST_ASSERT_EQUAL(2, msg->subscribers(Topic::Telemetry).size());
+    TEST_ASSERT_EQUAL(0, msg->subscribers(Topic::Camera).size());
+    // a long text: all the subscribers share its block
+    size_t freeBlocks = Payload::freePoolBlocks();
+    {
+        Message telemetry{other->id(), Topic::Telemetry, ""};
+        for (int i = 0; i < 10; ++i)
+            telemetry.print("rpm=2500 speed=88 ");
+        TEST_ASSERT(telemetry.isPublished())
+        TEST_ASSERT_FALSE(telemetry.isForAll())
+        msg->pushMessage(telemetry);
+    }
+    msg->update();
+    TEST_ASSERT_EQUAL(1, first->messageSize());
+    TEST_ASSERT_EQUAL(1, second->messageSize());
+    TEST_ASSERT_EQUAL(0, other->messageSize());
+    TEST_ASSERT_EQUAL(freeBlocks - 1, Payload::freePoolBlocks());
+    first->update();
+    second->update();
+    TEST_ASSERT_EQUAL(freeBlocks, Payload::freePoolBlocks());
+    // no more delivery after unsubscription
+    second->ignore();
+    msg->pushMessage(Message{other->id(), Topic::Telemetry, "rpm=800"});
+    msg->update();
+    TEST_ASSERT_EQUAL(1, first->messageSize());
+    TEST_ASSERT_EQUAL(0, second->messageSize());
+    // a topic without subscriber
+    msg->pushMessage(Message{other->id(), Topic::Camera, "recording"});
+    msg->update();
+    TEST_ASSERT_EQUAL(1, msg->deadLetters().size());
+    TEST_ASSERT_EQUAL(Delivery::Status::Unreachable, msg->deadLetters()[0].reason);
+}
+
+/**
+ * @brief Node keeping only its last message
+ */
+class LastNode : public Node {
+public:
+    explicit LastNode(std::shared_ptr<Messenger> msg) :
+        Node{std::move(msg)} {
+        setQueuePolicy(obd::data::OverflowPolicy::DropOldest, 1);
+    }
+};
+
+void test_headOfLine() {
+    std::shared_ptr<Manager> mng   = std::make_shared<Manager>();
+    std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(mng);
+    auto small                     = std::make_shared<SmallNode>(msg);
+    auto other                     = std::make_shared<Subscriber<1>>(msg);
+    auto last                      = std::make_shared<LastNode>(msg);
+    mng->addNode(small);
+    mng->addNode(other);
+    mng->addNode(last);
+    mng->init();
+    // a saturated node only delays its own messages
+    msg->pushMessage(Message{0, small->id(), "1"});
+    msg->pushMessage(Message{0, small->id(), "2"});
+    msg->pushMessage(Message{0, small->id(), "3"});
+    msg->pushMessage(Message{0, small->id(), "4"});
+    msg->pushMessage(Message{0, other->id(), "go"});
+    msg->update();
+    TEST_ASSERT_EQUAL(2, small->messageSize());
+    TEST_ASSERT_EQUAL(1, other->messageSize());
+    TEST_ASSERT_EQUAL(2, msg->size());
+    small->update();
+    msg->update();
+    TEST_ASSERT_EQUAL(0, msg->size());
+    // still in order for the saturated node
+    TEST_ASSERT_EQUAL_STRING("3", small->queued(0).getMessage().c_str());
+    TEST_ASSERT_EQUAL_STRING("4", small->queued(1).getMessage().c_str());
+    TEST_ASSERT_EQUAL(0, msg->deadLetters().size());
+    // the message discarded by a node's queue is dead-lettered
+    TEST_ASSERT(last->pushMessage(Message{0, last->id(), "old"}))
+    TEST_ASSERT(last->pushMessage(Message{0, last->id(), "new"}))
+    TEST_ASSERT_EQUAL(1, msg->deadLetters().size());
+    TEST_ASSERT_EQUAL(Delivery::Status::Saturated, msg->deadLetters()[0].reason);
+    TEST_ASSERT_EQUAL_STRING("old", msg->deadLetters()[0].message.getMessage().c_str());
+}
+
+/**
+ * @brief Subscriber holding a few messages (one type per instance)
+ */
+template<int Index>
+class FullSubscriber : public Node {
+public:
+    FullSubscriber(std::shared_ptr<Messenger> msg, size_t limit) :
+        Node{std::move(msg)} {
+        setQueuePolicy(obd::data::OverflowPolicy::Reject, limit);
+    }
+    /**
+     * @brief Receive the telemetry
+     */
+    void listen() { subscribe(Topic::Telemetry); }
+};
+
+void test_fanOutLetters() {
+    std::shared_ptr<Manager> mng   = std::make_shared<Manager>();
+    std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(mng);
+    auto fast                      = std::make_shared<FullSubscriber<1>>(msg, 2);
+    auto full                      = std::make_shared<FullSubscriber<2>>(msg, 1);
+    mng->addNode(fast);
+    mng->addNode(full);
+    mng->init();
+    fast->listen();
+    full->listen();
+    msg->pushMessage(Message{fast->id(), Topic::Telemetry, "rpm=800"});
+    msg->pushMessage(Message{fast->id(), Topic::Telemetry, "rpm=900"});
+    msg->update();
+    // the fast subscriber got both, the full one lost the second
+    TEST_ASSERT_EQUAL(2, fast->messageSize());
+    TEST_ASSERT_EQUAL(1, full->messageSize());
+    TEST_ASSERT_EQUAL(1, msg->deadLetters().size());
+    TEST_ASSERT_EQUAL(Delivery::Status::Saturated, msg->deadLetters()[0].reason);
+    TEST_ASSERT_EQUAL(full->id(), msg->deadLetters()[0].recipient);
+    TEST_ASSERT_EQUAL_STRING("rpm=900", msg->deadLetters()[0].message.getMessage().c_str());
+    // nobody accepts: one letter per recipient, none for the whole message
+    msg->pushMessage(Message{fast->id(), Topic::Telemetry, "rpm=1000"});
+    msg->update();
+    TEST_ASSERT_EQUAL(3, msg->deadLetters().size());
+    TEST_ASSERT_EQUAL(fast->id(), msg->deadLetters()[1].recipient);
+    TEST_ASSERT_EQUAL(full->id(), msg->deadLetters()[2].recipient);
+}
+
+/**
+ * @brief Node with a long information text
+ */
+class InfoNode : public Node {
+public:
+    explicit InfoNode(std::shared_ptr<Messenger> msg) :
+        Node{std::move(msg)} {
+        for (int i = 0; i < 25; ++i)
+            text += "RunCam Feature ........ true\n";
+    }
+    [[nodiscard]] Message::DataType info() const override { return text; }
+
+private:
+    /// The information text
+    Message::DataType text;
+};
+
+void test_sharedBody() {
+    std::shared_ptr<Manager> mng   = std::make_shared<Manager>();
+    std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(mng);
+    auto infoNode                  = std::make_shared<InfoNode>(msg);
+    auto first                     = std::make_shared<Subscriber<1>>(msg);
+    auto second                    = std::make_shared<Subscriber<2>>(msg);
+    mng->addNode(infoNode);
+    mng->addNode(first);
+    mng->addNode(second);
+    mng->init();
+    size_t freeBlocks = Payload::freePoolBlocks();
+    TEST_ASSERT_EQUAL(725, infoNode->info().size());
+    // the reply shares the node's text
+    msg->pushMessage(Message{first->id(), infoNode->id(), "info", Message::MessageType::Command});
+    msg->update();
+    mng->update();
+    msg->update();
+    TEST_ASSERT_EQUAL(1, first->messageSize());
+    TEST_ASSERT_EQUAL(freeBlocks, Payload::freePoolBlocks());
+    // a broadcast of a long text keeps one block for all the nodes
+    msg->pushMessage(Message{first->id(), broadcastId, infoNode->info()});
+    msg->update();
+    TEST_ASSERT_EQUAL(2, first->messageSize());
+    TEST_ASSERT_EQUAL(1, second->messageSize());
+    TEST_ASSERT_EQUAL(1, infoNode->messageSize());
+    TEST_ASSERT_EQUAL(freeBlocks, Payload::freePoolBlocks());
+    // the node, the 4 queued messages and the returned copy
+    TEST_ASSERT_EQUAL(6, infoNode->info().useCount());
+    mng->update();
+    TEST_ASSERT_EQUAL(2, infoNode->info().useCount());
+}
+
+/**
+ * @brief Node that lets the test send its messages
+ */
+class SenderNode : public Node {
+public:
+    using Node::Node;
+    using Node::broadcastMessage;
+};
+
+void test_saturatedLane() {
+    std::shared_ptr<Manager> mng     = std::make_shared<Manager>();
+    std::shared_ptr<Messenger> msg   = std::make_shared<Messenger>(mng);
+    std::shared_ptr<SenderNode> node = std::make_shared<SenderNode>(msg);
+    mng->addNode(node);
+    node->init();
+    // the sender is told, and the refused message is kept
+    msg->setQueuePolicy(obd::data::OverflowPolicy::Reject, 2);
+    TEST_ASSERT(node->broadcastMessage(node->id(), "1"))
+    TEST_ASSERT(node->broadcastMessage(node->id(), "2"))
+    TEST_ASSERT_EQUAL(Delivery::Status::Saturated, node->broadcastMessage(node->id(), "3").status());
+    TEST_ASSERT_EQUAL(1, msg->deadLetters().size());
+    TEST_ASSERT_EQUAL(Delivery::Status::Saturated, msg->deadLetters()[0].reason);
+    TEST_ASSERT_EQUAL_STRING("3", msg->deadLetters()[0].message.getMessage().c_str());
+    // the other lanes are not full
+    TEST_ASSERT(msg->pushMessage(Message{0, node->id(), "info", Message::MessageType::Command}))
+    // the discarded message is kept
+    msg->setQueuePolicy(obd::data::OverflowPolicy::DropOldest, 2);
+    TEST_ASSERT(msg->pushMessage(Message{0, node->id(), "4"}))
+    TEST_ASSERT_EQUAL(2, msg->deadLetters().size());
+    TEST_ASSERT_EQUAL_STRING("1", msg->deadLetters()[1].message.getMessage().c_str());
+    TEST_ASSERT_EQUAL(2, msg->size(Messenger::Lane::Background));
+    // no messenger
+    SenderNode alone(nullptr);
+    TEST_ASSERT_EQUAL(Delivery::Status::Unreachable, alone.broadcastMessage(0, "lost").status());
 }
 
 void test_name(){
@@ -62,13 +397,23 @@ void test_name(){
     TEST_ASSERT_EQUAL_STRING("Unknown", msger->computeName(111).c_str());
     auto node = baseSys.getNode<obd::gfx::StatusLed>();
     TEST_ASSERT_NOT_NULL(msger)
-    TEST_ASSERT_EQUAL_STRING("StatusLed", msger->computeName(node->type()).c_str());
+    TEST_ASSERT_EQUAL_STRING("StatusLed", msger->computeName(node->id()).c_str());
+    TEST_ASSERT_EQUAL(node->id(), msger->computeId(OString{"StatusLed"}));
+    TEST_ASSERT_EQUAL(broadcastId, msger->computeId(OString{"All"}));
+    TEST_ASSERT_EQUAL(unknownId, msger->computeId(OString{"StatusLeed"}));
 }
 
 void test_all() {
     UNITY_BEGIN();
     RUN_TEST(test_void);
     RUN_TEST(test_managed);
+    RUN_TEST(test_lanes);
+    RUN_TEST(test_backpressure);
+    RUN_TEST(test_topics);
+    RUN_TEST(test_sharedBody);
+    RUN_TEST(test_saturatedLane);
+    RUN_TEST(test_fanOutLetters);
+    RUN_TEST(test_headOfLine);
     RUN_TEST(test_name);
     UNITY_END();
 }
@@ -44,9 +44,9 @@ void test_message() {
     // bad destination
     TEST_ASSERT_FALSE(drv.pushMessage(Message{0, 1, "bob", Message::MessageType::Command}))
     // command unknown
-    TEST_ASSERT_FALSE(drv.pushMessage(Message{0, drv.type(), "bob", Message::MessageType::Command}))
+    TEST_ASSERT_FALSE(drv.pushMessage(Message{0, drv.id(), "bob", Message::MessageType::Command}))
     // known command
-    TEST_ASSERT(drv.pushMessage(Message{0, drv.type(), "info", Message::MessageType::Command}))
+    TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), "info", Message::MessageType::Command}))
     // known command sent to all
     TEST_ASSERT(drv.pushMessage(Message{0, 0, "info", Message::MessageType::Command}))
     // known command but destination unknown
@@ -57,14 +57,14 @@ void test_treatMessages() {
     std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(nullptr);
     Node drv(msg);
     drv.init();
-    TEST_ASSERT(drv.pushMessage(Message{0, drv.type(), "info", Message::MessageType::Command}))
-    TEST_ASSERT(drv.pushMessage(Message{0, drv.type(), "hello!", Message::MessageType::Message}))
-    TEST_ASSERT(drv.pushMessage(Message{0, drv.type(), "info", Message::MessageType::Reply}))
-    TEST_ASSERT(drv.pushMessage(Message{0, drv.type(), "info", Message::MessageType::Command}))
-    TEST_ASSERT(drv.pushMessage(Message{0, drv.type(), "info", Message::MessageType::Message}))
-    TEST_ASSERT(drv.pushMessage(Message{0, drv.type(), "info", Message::MessageType::Command}))
-    TEST_ASSERT(drv.pushMessage(Message{0, drv.type(), "info", Message::MessageType::Command}))
-    TEST_ASSERT_FALSE(drv.pushMessage(Message{0, drv.type(), "boby", Message::MessageType::Command}))
+    TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), "info", Message::MessageType::Command}))
+    TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), "hello!", Message::MessageType::Message}))
+    TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), "info", Message::MessageType::Reply}))
+    TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), "info", Message::MessageType::Command}))
+    TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), "info", Message::MessageType::Message}))
+    TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), "info", Message::MessageType::Command}))
+    TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), "info", Message::MessageType::Command}))
+    TEST_ASSERT_FALSE(drv.pushMessage(Message{0, drv.id(), "boby", Message::MessageType::Command}))
     TEST_ASSERT_EQUAL(7, drv.queueSize());
     drv.update();
     TEST_ASSERT_EQUAL(1, drv.queueSize());
@@ -72,11 +72,169 @@ void test_treatMessages() {
     TEST_ASSERT_EQUAL(0, drv.queueSize());
 }
 
+void test_overflow() {
+    std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(nullptr);
+    Node drv(msg);
+    drv.init();
+    for (size_t i = 0; i < drv.queueCapacity(); ++i)
+        TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), "hello!"}))
+    TEST_ASSERT_FALSE(drv.pushMessage(Message{0, drv.id(), "hello!"}))
+    TEST_ASSERT_EQUAL(drv.queueCapacity(), drv.queueSize());
+    TEST_ASSERT_EQUAL(1, drv.stats().rejectedMessages);
+    TEST_ASSERT_EQUAL(1, drv.stats().overflowMessages());
+    TEST_ASSERT_EQUAL(drv.queueCapacity(), drv.stats().maxQueueSize);
+}
+
+/**
+ * @brief Node with a queue sized at compile time
+ */
+class SmallQueueNode : public Node {
+public:
+    explicit SmallQueueNode(std::shared_ptr<Messenger> messenger) :
+        Node{std::move(messenger), queueStorage} {}
+
+private:
+    QueueStorage<2> queueStorage;
+};
+
+void test_queueStorage() {
+    std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(nullptr);
+    SmallQueueNode drv(msg);
+    drv.init();
+    TEST_ASSERT_EQUAL(2, drv.queueCapacity());
+    TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), "hello!"}))
+    TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), "hello!"}))
+    TEST_ASSERT_FALSE(drv.pushMessage(Message{0, drv.id(), "hello!"}))
+    drv.update();
+    TEST_ASSERT_EQUAL(0, drv.queueSize());
+}
+
+/**
+ * @brief Node with its own command table
+ */
+class TableNode : public Node {
+public:
+    explicit TableNode(std::shared_ptr<Messenger> msg) :
+        Node{std::move(msg)} {}
+    static constexpr CommandId Date = nodeCommand(0);///< Count
+    static constexpr CommandId Zone = nodeCommand(1);///< Store a zone
+    static constexpr CommandId Menu = nodeCommand(2);///< Move
+    /// Number of date commands executed
+    uint8_t dates = 0;
+    /// Last received zone
+    OString zone;
+    /// Last received menu move
+    uint8_t move = Command::noArgument;
+
+protected:
+    [[nodiscard]] CommandTable commands() const override {
+        static constexpr const char* moves[] = {"left", "right"};
+        static constexpr CommandEntry table[] = {
+                {Date, "date", 0, commandHandler<&TableNode::cmdDate>(), "Count", {}},
+                {Zone, "zone", 1, commandHandler<&TableNode::cmdZone>(), "<zone> Store", {}},
+                {Menu, "Menu", 1, commandHandler<&TableNode::cmdMenu>(), "<left|right> Move", moves},
+        };
+        static_assert(CommandTable::sorted(table), "commands must be sorted by id");
+        return table;
+    }
+
+private:
+    void cmdDate([[maybe_unused]] const Message& message) { ++dates; }
+    void cmdZone(const Message& message) { zone = OString{message.getWords(1)[0]}; }
+    void cmdMenu(const Message& message) { move = message.getCommand().argument; }
+};
+
+void test_commandTable() {
+    std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(nullptr);
+    TableNode drv(msg);
+    drv.init();
+    TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), "date", Message::MessageType::Command}))
+    TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), Command{TableNode::Date}}))
+    TEST_ASSERT_FALSE(drv.pushMessage(Message{0, drv.id(), "led", Message::MessageType::Command}))
+    // base commands still accepted
+    TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), "help", Message::MessageType::Command}))
+    drv.update();
+    TEST_ASSERT_EQUAL(2, drv.dates);
+    TEST_ASSERT_EQUAL(2, msg->size());// unknown command warning, help reply
+    // arity check: accepted, but not executed
+    TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), "zone", Message::MessageType::Command}))
+    drv.update();
+    TEST_ASSERT(drv.zone.empty())
+    TEST_ASSERT_EQUAL(3, msg->size());// error reply
+    TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), "zone UTC", Message::MessageType::Command}))
+    drv.update();
+    TEST_ASSERT_EQUAL_STRING("UTC", drv.zone.c_str());
+    // argument keywords of the node's table
+    TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), "Menu right", Message::MessageType::Command}))
+    drv.update();
+    TEST_ASSERT_EQUAL(1, drv.move);
+    TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), "Menu up", Message::MessageType::Command}))
+    drv.update();
+    TEST_ASSERT_EQUAL(Command::unknownArgument, drv.move);
+    TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), Command{TableNode::Menu, 0}}))
+    drv.update();
+    TEST_ASSERT_EQUAL(0, drv.move);
+    // command written after the construction
+    Message printed{0, drv.id(), Message::MessageType::Command};
+    printed.print("Menu ");
+    printed.print("right");
+    TEST_ASSERT(drv.pushMessage(printed))
+    drv.update();
+    TEST_ASSERT_EQUAL(1, drv.move);
+    static constexpr CommandEntry unsorted[] = {
+            {TableNode::Zone, "", 0, nullptr, "", {}},
+            {TableNode::Date, "", 0, nullptr, "", {}},
+    };
+    static_assert(!CommandTable::sorted(unsorted));
+    constexpr CommandTable view{unsorted};
+    static_assert(view.size() == 2);
+    TEST_ASSERT_NULL(CommandTable{}.find(TableNode::Date));
+}
+
+void test_histogram() {
+    Histogram histogram;
+    TEST_ASSERT_EQUAL(0, histogram.percentile(99));
+    for (uint64_t value = 1; value <= 100; ++value)
+        histogram.account(value);
+    TEST_ASSERT_EQUAL(100, histogram.count());
+    TEST_ASSERT_EQUAL(1, histogram.min());
+    TEST_ASSERT_EQUAL(100, histogram.max());
+    TEST_ASSERT_EQUAL(50, histogram.average());
+    // 64..100 share the bucket [64, 127]: bounded by the maximum
+    TEST_ASSERT_EQUAL(100, histogram.percentile(99));
+    // 50th sample is in the bucket [32, 63]
+    TEST_ASSERT_EQUAL(63, histogram.percentile(50));
+    histogram.account(uint64_t{1} << 40);
+    TEST_ASSERT_EQUAL(uint64_t{1} << 40, histogram.percentile(100));
+    histogram.reset();
+    TEST_ASSERT_EQUAL(0, histogram.count());
+    TEST_ASSERT_EQUAL(0, histogram.max());
+}
+
+void test_profile() {
+    std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(nullptr);
+    Node drv(msg);
+    drv.init();
+    drv.update();
+    TEST_ASSERT(drv.pushMessage(Message{0, drv.id(), "info", Message::MessageType::Command}))
+    drv.update();
+    TEST_ASSERT_EQUAL(2, drv.profile().preTreatment.count());
+    TEST_ASSERT_EQUAL(1, drv.profile().messages.count());
+    TEST_ASSERT_EQUAL(2, drv.profile().postTreatment.count());
+    drv.resetProfile();
+    TEST_ASSERT_EQUAL(0, drv.profile().preTreatment.count());
+}
+
 void test_all() {
     UNITY_BEGIN();
     RUN_TEST(test_creation);
     RUN_TEST(test_initialization);
     RUN_TEST(test_message);
     RUN_TEST(test_treatMessages);
+    RUN_TEST(test_overflow);
+    RUN_TEST(test_queueStorage);
+    RUN_TEST(test_commandTable);
+    RUN_TEST(test_histogram);
+    RUN_TEST(test_profile);
     UNITY_END();
 }
@@ -135,6 +135,12 @@ void test_printLargerInt() {
     message.println(static_cast<uint64_t>('G'), Format{-1});
     TEST_ASSERT_EQUAL_STRING("\n", message.getMessage().c_str());
     message.clear();
+    message.println(static_cast<int32_t>(-71));
+    TEST_ASSERT_EQUAL_STRING("-71\n", message.getMessage().c_str());
+    message.clear();
+    message.println(static_cast<int16_t>(-1), Format::Hexadecimal);
+    TEST_ASSERT_EQUAL_STRING("ffff\n", message.getMessage().c_str());
+    message.clear();
     message.println(static_cast<int64_t>('G'), Format{-1});
     TEST_ASSERT_EQUAL_STRING("\n", message.getMessage().c_str());
     message.clear();
@@ -161,6 +167,9 @@ void test_printDouble() {
     message.println(3.14159, 8);
     TEST_ASSERT_EQUAL_STRING("3.14159000\n", message.getMessage().c_str());
     message.clear();
+    message.println(-2.5, 1);
+    TEST_ASSERT_EQUAL_STRING("-2.5\n", message.getMessage().c_str());
+    message.clear();
 }
 
 void test_printStrings() {
@@ -174,6 +183,132 @@ void test_printStrings() {
     message.clear();
 }
 
+void test_payload() {
+    Payload small{"hello"};
+    TEST_ASSERT(small.isInline())
+    TEST_ASSERT_EQUAL(5, small.size());
+    TEST_ASSERT_EQUAL(1, small.find('e'));
+    TEST_ASSERT_EQUAL(Payload::npos, small.find('z'));
+    TEST_ASSERT_EQUAL_STRING("ell", small.substr(1, 3).c_str());
+    TEST_ASSERT(small == "hello")
+    size_t freeBlocks = Payload::freePoolBlocks();
+    Payload large{small};
+    for (int i = 0; i < 40; ++i)
+        large += " world";
+    TEST_ASSERT_FALSE(large.isInline())
+    TEST_ASSERT_EQUAL(245, large.size());
+    TEST_ASSERT_EQUAL(freeBlocks - 1, Payload::freePoolBlocks());
+    Payload moved{std::move(large)};
+    TEST_ASSERT(large.empty())
+    TEST_ASSERT_EQUAL(245, moved.size());
+    TEST_ASSERT_EQUAL(freeBlocks - 1, Payload::freePoolBlocks());
+    // copies share the text until modified
+    Payload copied{moved};
+    TEST_ASSERT_EQUAL(freeBlocks - 1, Payload::freePoolBlocks());
+    TEST_ASSERT_EQUAL(2, moved.useCount());
+    TEST_ASSERT_EQUAL(moved.c_str(), copied.c_str());
+    copied += "!";
+    TEST_ASSERT_EQUAL(freeBlocks - 2, Payload::freePoolBlocks());
+    TEST_ASSERT_EQUAL(1, moved.useCount());
+    TEST_ASSERT_EQUAL(245, moved.size());
+    TEST_ASSERT_EQUAL(246, copied.size());
+    copied = moved;
+    TEST_ASSERT_EQUAL(freeBlocks - 1, Payload::freePoolBlocks());
+    copied.clear();
+    TEST_ASSERT(copied.isInline())
+    TEST_ASSERT_EQUAL(245, moved.size());
+    copied = small;
+    TEST_ASSERT_EQUAL_STRING("hello", copied.c_str());
+    TEST_ASSERT(copied.isInline())
+    TEST_ASSERT_EQUAL(freeBlocks - 1, Payload::freePoolBlocks());
+    moved = Payload{};
+    TEST_ASSERT_EQUAL(freeBlocks, Payload::freePoolBlocks());
+}
+
+void test_command() {
+    static constexpr const char* states[] = {"off", "solid", "blink"};
+    constexpr CommandId led = nodeCommand(0);
+    // the nodes' keywords are resolved by the node
+    Message text(0, 5, "led  blink now", Message::MessageType::Command);
+    TEST_ASSERT_EQUAL(CommandId::Unknown, text.getCommand().id);
+    TEST_ASSERT(text.getCommand().hasArgument())
+    TEST_ASSERT_FALSE(text.getCommand().validArgument())
+    text.resolveCommand(led, states);
+    TEST_ASSERT_EQUAL(led, text.getCommand().id);
+    TEST_ASSERT_EQUAL(2, text.getCommand().argument);
+    Message bad(0, 5, "led xmas", Message::MessageType::Command);
+    TEST_ASSERT(bad.getCommand().hasArgument())
+    bad.resolveCommand(led, states);
+    TEST_ASSERT_FALSE(bad.getCommand().validArgument())
+    Message alone(0, 5, "help", Message::MessageType::Command);
+    TEST_ASSERT_EQUAL(CommandId::Help, alone.getCommand().id);
+    TEST_ASSERT_FALSE(alone.getCommand().hasArgument())
+    // only commands and inputs are parsed
+    Message reply(0, 5, "help off", Message::MessageType::Reply);
+    TEST_ASSERT_EQUAL(CommandId::None, reply.getCommand().id);
+    reply.setType(Message::MessageType::Command);
+    TEST_ASSERT_EQUAL(CommandId::Help, reply.getCommand().id);
+    TEST_ASSERT(reply.getCommand().hasArgument())
+    // parsed again when the text changes
+    Message printed(0, 5, Message::MessageType::Command);
+    TEST_ASSERT_EQUAL(CommandId::None, printed.getCommand().id);
+    printed.print("info");
+    TEST_ASSERT_EQUAL(CommandId::Info, printed.getCommand().id);
+    TEST_ASSERT_FALSE(printed.getCommand().hasArgument())
+    printed.print(" solid");
+    TEST_ASSERT(printed.getCommand().hasArgument())
+    printed.clear();
+    printed.print("dmesg");
+    TEST_ASSERT_EQUAL(CommandId::Dmesg, printed.getCommand().id);
+    // typed command without text
+    Message typed(0, 5, Command{nodeCommand(3), 3});
+    TEST_ASSERT_EQUAL(Message::MessageType::Command, typed.getType());
+    TEST_ASSERT(typed.empty())
+    TEST_ASSERT_EQUAL(nodeCommand(3), typed.getCommand().id);
+    TEST_ASSERT_EQUAL(3, typed.getCommand().argument);
+    typed.resolveCommand(led, states);
+    TEST_ASSERT_EQUAL(nodeCommand(3), typed.getCommand().id);
+}
+
+void test_tokenizer() {
+    Message message(0, 5, "  zone \"Europe/Paris CET\"  now ", Message::MessageType::Command);
+    auto words = message.getWords();
+    TEST_ASSERT_EQUAL(3, words.size());
+    TEST_ASSERT(words[0] == "zone")
+    TEST_ASSERT(words[1] == "Europe/Paris CET")
+    TEST_ASSERT(words[2] == "now")
+    TEST_ASSERT(words[3].empty())
+    uint8_t count = 0;
+    for (auto word : message.getWords(1)) {
+        TEST_ASSERT_FALSE(word.empty())
+        ++count;
+    }
+    TEST_ASSERT_EQUAL(2, count);
+    TEST_ASSERT_EQUAL_STRING("\"Europe/Paris CET\"  now ", message.getParamStr().c_str());
+    obd::data::Arena arena;
+    TEST_ASSERT_EQUAL_STRING("\"Europe/Paris CET\"  now ", message.getParamStr(&arena).c_str());
+    TEST_ASSERT_EQUAL_STRING("zone", message.getBaseCommand().c_str());
+    TEST_ASSERT(arena.used() > 0)
+    TEST_ASSERT_EQUAL_STRING("Europe/Paris CET", message.getParams()[0].c_str());
+    // spans follow copies
+    Message copy = message;
+    TEST_ASSERT(copy.getWords()[2] == "now")
+    // printing updates the words
+    message.print(" later");
+    TEST_ASSERT_EQUAL(4, message.getWords().size());
+    TEST_ASSERT(message.getWords()[3] == "later")
+    // unterminated quote and too many words
+    Tokenizer tokenizer;
+    const char* text = "a \"b c";
+    tokenizer.parse(text, 6);
+    TEST_ASSERT_EQUAL(2, tokenizer.size());
+    TEST_ASSERT(tokenizer.range(text)[1] == "b c")
+    text = "1 2 3 4 5 6 7 8";
+    tokenizer.parse(text, 15);
+    TEST_ASSERT_EQUAL(Tokenizer::maxTokens, tokenizer.size());
+    TEST_ASSERT(tokenizer.isTruncated())
+}
+
 void test_all() {
     UNITY_BEGIN();
     RUN_TEST(test_creation);
@@ -182,5 +317,8 @@ void test_all() {
     RUN_TEST(test_printLargerInt);
     RUN_TEST(test_printDouble);
     RUN_TEST(test_printStrings);
+    RUN_TEST(test_payload);
+    RUN_TEST(test_command);
+    RUN_TEST(test_tokenizer);
     UNITY_END();
 }
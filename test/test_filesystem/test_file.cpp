@@ -10,6 +10,7 @@
 #include "fs/File.h"
 #include "fs/FileSystem.h"
 #include "fs/ConfigFile.h"
+#include "fs/MappedFile.h"
 
 using namespace obd::fs;
 
@@ -52,6 +53,102 @@ void test_file_read() {
     file.close();
 }
 
+void test_file_buffer() {
+    std::shared_ptr<FileSystem> hdd = baseSys.getNode<FileSystem>();
+    // a buffer smaller than the lines: blocks split the lines
+    char small[8];
+    TextFile file(hdd);
+    TEST_ASSERT_FALSE(file.setBuffer(small, 0))
+    TEST_ASSERT(file.setBuffer(small, sizeof(small)))
+    TEST_ASSERT(file.open(Path{"/buffer.txt"}, ios::out))
+    TEST_ASSERT_FALSE(file.setBuffer(small, sizeof(small)))
+    file.write("first line\r\n");
+    file.write('2');
+    file.write("\nthe last line, longer than the buffer");
+    file.flush();
+    file.write("!");
+    file.close();
+    TEST_ASSERT(file.open(Path{"/buffer.txt"}, ios::in))
+    TEST_ASSERT_EQUAL_STRING("first line", file.readLine(255, false).c_str());
+    TEST_ASSERT_EQUAL_STRING("2\n", file.readLine().c_str());
+    TEST_ASSERT_EQUAL_STRING("the last", file.readLine(8).c_str());
+    TEST_ASSERT_EQUAL(' ', file.read());
+    TEST_ASSERT_EQUAL_STRING("line, longer than the buffer!", file.readLine().c_str());
+    TEST_ASSERT_FALSE(file.available())
+    TEST_ASSERT_EQUAL(0, file.read());
+    file.close();
+    TEST_ASSERT(hdd->rm(Path{"/buffer.txt"}))
+}
+
+void test_binary_file() {
+    std::shared_ptr<FileSystem> hdd = baseSys.getNode<FileSystem>();
+    BinaryFile image(hdd, Path{"/title.odb"});
+    TEST_ASSERT(image.isOpened())
+    // RGB565 image: width and height, then the pixels
+    uint16_t header[2];
+    TEST_ASSERT_EQUAL(4, image.read({reinterpret_cast<uint8_t*>(header), sizeof(header)}));
+    TEST_ASSERT_EQUAL(800, header[0]);
+    TEST_ASSERT_EQUAL(480, header[1]);
+    TEST_ASSERT_EQUAL(4, image.tell());
+    TEST_ASSERT_EQUAL(4 + 800 * 480 * 2, image.size());
+    TEST_ASSERT_EQUAL(4, image.tell());
+    std::array<uint8_t, 16> block{};
+    TEST_ASSERT(image.seek(image.size() - 10))
+    TEST_ASSERT_EQUAL(10, image.read(block));
+    TEST_ASSERT_EQUAL(0, image.read(block));
+    TEST_ASSERT(image.seek(0))
+    TEST_ASSERT_EQUAL(16, image.read(block));
+    TEST_ASSERT_EQUAL(0, image.write(block));
+    image.close();
+    TEST_ASSERT_EQUAL(0, image.read(block));
+
+    BinaryFile out(hdd, Path{"/binary.bin"}, ios::out);
+    std::array<uint8_t, 4> values{1, 2, 3, 4};
+    TEST_ASSERT_EQUAL(4, out.write(values));
+    TEST_ASSERT_EQUAL(4, out.size());
+    TEST_ASSERT(out.seek(1))
+    TEST_ASSERT_EQUAL(2, out.write(obd::data::Span<const uint8_t>(values).subspan(2)));
+    out.close();
+    BinaryFile in(hdd, Path{"/binary.bin"});
+    TEST_ASSERT_EQUAL(4, in.read(block));
+    TEST_ASSERT_EQUAL(1, block[0]);
+    TEST_ASSERT_EQUAL(3, block[1]);
+    TEST_ASSERT_EQUAL(4, block[2]);
+    TEST_ASSERT_EQUAL(4, block[3]);
+    in.close();
+    TEST_ASSERT(hdd->rm(Path{"/binary.bin"}))
+}
+
+void test_mapped_file() {
+    std::shared_ptr<FileSystem> hdd = baseSys.getNode<FileSystem>();
+    MappedFile missing(hdd, Path{"/missing.odb"});
+    TEST_ASSERT_FALSE(missing.isOpened())
+    TEST_ASSERT(missing.view().empty())
+    MappedFile image(hdd, Path{"/title.odb"});
+    TEST_ASSERT(image.isOpened())
+    TEST_ASSERT_EQUAL(4 + 800 * 480 * 2, image.size());
+    auto header = image.view(0, 4);
+    TEST_ASSERT_EQUAL(4, header.size());
+    TEST_ASSERT_EQUAL(800, header[0] | header[1] << 8);
+    TEST_ASSERT_EQUAL(480, header[2] | header[3] << 8);
+    // the end of the file limits the view
+    TEST_ASSERT_EQUAL(10, image.view(image.size() - 10).size());
+    TEST_ASSERT(image.view(image.size()).empty())
+    // same content as the file, by blocks
+    BinaryFile file(hdd, Path{"/title.odb"});
+    std::array<uint8_t, 100> block{};
+    size_t offset = 0;
+    while (offset < image.size()) {
+        auto part = image.view(offset, block.size());
+        TEST_ASSERT_EQUAL(part.size(), file.read({block.data(), part.size()}));
+        TEST_ASSERT(std::equal(part.begin(), part.end(), block.begin()))
+        offset += part.size();
+    }
+    image.close();
+    TEST_ASSERT_EQUAL(0, image.size());
+    TEST_ASSERT(image.view().empty())
+}
+
 void test_config_file(){
     auto hdd = baseSys.getNode<FileSystem>();
     // testing bad things
@@ -5,7 +5,8 @@
  * Copyright © 2022 All rights reserved.
  * All modification must get authorization from the author.
  */
-#include "../test_base.h"
+#include "../test_helper.h"
+#include "fs/FileSystem.h"
 
 void test_path();
 void test_compact_absolute_path();
@@ -18,9 +19,14 @@ void test_filesystem();
 void test_directories();
 void test_uninitialized();
 void test_create_destroy();
+void test_dir_iterator();
+void test_stat_cache();
 
 void test_file();
 void test_file_read();
+void test_file_buffer();
+void test_binary_file();
+void test_mapped_file();
 void test_config_file();
 
 void test_all() {
@@ -37,9 +43,23 @@ void test_all() {
   RUN_TEST(test_filesystem);
   RUN_TEST(test_directories);
   RUN_TEST(test_create_destroy);
+  RUN_TEST(test_dir_iterator);
+  RUN_TEST(test_stat_cache);
   // test files
   RUN_TEST(test_file);
   RUN_TEST(test_file_read);
+  RUN_TEST(test_file_buffer);
+  RUN_TEST(test_binary_file);
+  RUN_TEST(test_mapped_file);
   RUN_TEST(test_config_file);
   UNITY_END();
 }
+
+void setup() {
+    // the file system is not a base node: add it before the initialization
+    baseSys.addNode<obd::fs::FileSystem>();
+    baseSys.init();
+    test_all();
+}
+
+void loop() {}
@@ -33,6 +33,9 @@ void test_path() {
   TEST_ASSERT(!p2.isAbsolute());
   p2.makeAbsolute(p);
   TEST_ASSERT_EQUAL_STRING("/toto/bob.odb", p2.toString().c_str());
+  Path p3("../titi//./bob.odb");
+  p3.makeAbsolute(Path{"/toto/tata"});
+  TEST_ASSERT_EQUAL_STRING("/toto/titi/bob.odb", p3.toString().c_str());
 }
 
 void test_compact_absolute_path() {
@@ -169,4 +172,13 @@ void test_make_relative_path() {
   p2 = Path{"/toto.txt"};
   p2.makeRelative(Path{"/"});
   TEST_ASSERT_EQUAL_STRING("toto.txt", p2.toString().c_str());
+  p2 = Path{"/toto"};
+  p2.makeRelative(Path{"/toto/titi"});
+  TEST_ASSERT_EQUAL_STRING("..", p2.toString().c_str());
+  p2 = Path{"/a"};
+  p2.makeRelative(Path{"/bibi/toto/titi/tutu"});
+  TEST_ASSERT_EQUAL_STRING("../../../../a", p2.toString().c_str());
+  p2 = Path{"/toto"};
+  p2.makeRelative(Path{"/toto"});
+  TEST_ASSERT_EQUAL_STRING(".", p2.toString().c_str());
 }
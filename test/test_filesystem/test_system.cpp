@@ -6,7 +6,11 @@
  * All modification must get authorization from the author.
  */
 #include "../test_helper.h"
+#include "com/Stdout.h"
+#include "core/StaticSystem.h"
 #include "fs/FileSystem.h"
+#include <iostream>
+#include <sstream>
 
 using namespace obd::fs;
 
@@ -88,3 +92,89 @@ void test_create_destroy() {
     hdd->cd(Path{"/"});
     TEST_ASSERT(hdd->rmdir(Path("/tmp5681234"), true))
 }
+
+void test_dir_iterator() {
+    auto hdd = baseSys.getNode<FileSystem>();
+    hdd->cd(Path{"/"});
+    TEST_ASSERT(hdd->mkdir(Path("/tmp5682234/folder"), true))
+    {
+        TextFile file(hdd, Path("/tmp5682234/file.txt"), obd::fs::ios::out);
+        file.write(OString("hello"));
+    }
+    auto dir = hdd->openDir(Path{"/tmp5682234"});
+    size_t count = 0;
+    while (dir.next()) {
+        ++count;
+        const auto& entry = dir.entry();
+        if (entry.path.toString() == "folder") {
+            TEST_ASSERT(entry.directory)
+            TEST_ASSERT_EQUAL(0, entry.size);
+        } else {
+            TEST_ASSERT_EQUAL_STRING("file.txt", entry.path.toString().c_str());
+            TEST_ASSERT_FALSE(entry.directory)
+            TEST_ASSERT_EQUAL(5, entry.size);
+        }
+    }
+    TEST_ASSERT_EQUAL(2, count);
+    TEST_ASSERT_FALSE(dir.next())
+    auto notDir = hdd->openDir(Path{"/tmp5682234/file.txt"});
+    TEST_ASSERT_FALSE(notDir.next())
+    // the listing is printed on the console
+    std::streambuf* oldCoutStreamBuf = std::cout.rdbuf();
+    std::ostringstream strCout;
+    std::cout.rdbuf(strCout.rdbuf());
+    {
+        using Console = obd::core::StaticSystem<FileSystem, obd::com::Shell, obd::com::Stdout>;
+        using obd::core::driver::Message;
+        Console console;
+        console.init();
+        auto& shell = console.getNode<obd::com::Shell>();
+        TEST_ASSERT(shell.pushMessage(Message{0, shell.id(), "FileSystem ls /tmp5682234", Message::MessageType::Input}))
+        for (int i = 0; i < 5; ++i)
+            console.update();
+    }
+    std::cout.rdbuf(oldCoutStreamBuf);
+    std::string result = strCout.str();
+    TEST_ASSERT(result.find("folder/\n") != std::string::npos)
+    TEST_ASSERT(result.find("file.txt 5\n") != std::string::npos)
+    TEST_ASSERT(result.find("ERROR") == std::string::npos)
+    TEST_ASSERT(hdd->rmdir(Path("/tmp5682234"), true))
+}
+
+void test_stat_cache() {
+    auto hdd = baseSys.getNode<FileSystem>();
+    hdd->cd(Path{"/"});
+    auto title = hdd->stat(Path("/title.odb"));
+    TEST_ASSERT(title.exists)
+    TEST_ASSERT_FALSE(title.directory)
+    TEST_ASSERT_EQUAL(800 * 480 * 2 + 4, title.size);
+    // the same path, relative or absolute, is answered by the cache
+    size_t misses = hdd->statMisses();
+    size_t hits   = hdd->statHits();
+    TEST_ASSERT(hdd->isFile(Path("title.odb")))
+    TEST_ASSERT(hdd->exists(Path("/title.odb")))
+    TEST_ASSERT_EQUAL(misses, hdd->statMisses());
+    TEST_ASSERT_EQUAL(hits + 2, hdd->statHits());
+    // changes through the filesystem are seen
+    TEST_ASSERT_FALSE(hdd->exists(Path("/tmp5683234")))
+    TEST_ASSERT(hdd->mkdir(Path("/tmp5683234")))
+    TEST_ASSERT(hdd->isDir(Path("/tmp5683234")))
+    TEST_ASSERT_FALSE(hdd->exists(Path("/tmp5683234/file.txt")))
+    TEST_ASSERT(hdd->touch(Path("/tmp5683234/file.txt")))
+    TEST_ASSERT(hdd->isFile(Path("/tmp5683234/file.txt")))
+    TEST_ASSERT_EQUAL(0, hdd->stat(Path("/tmp5683234/file.txt")).size);
+    {
+        TextFile file(hdd, Path("/tmp5683234/file.txt"), obd::fs::ios::out);
+        file.write(OString("abc"));
+    }
+    TEST_ASSERT_EQUAL(3, hdd->stat(Path("/tmp5683234/file.txt")).size);
+    TEST_ASSERT(hdd->rm(Path("/tmp5683234/file.txt")))
+    TEST_ASSERT_FALSE(hdd->exists(Path("/tmp5683234/file.txt")))
+    TEST_ASSERT(hdd->rmdir(Path("/tmp5683234")))
+    TEST_ASSERT_FALSE(hdd->exists(Path("/tmp5683234")))
+    // more paths than the cache holds
+    for (int i = 0; i < 2 * obd::config::statCacheLength; ++i) {
+        TEST_ASSERT_FALSE(hdd->exists(Path("/missing" + std::to_string(i))))
+    }
+    TEST_ASSERT(hdd->isFile(Path("/title.odb")))
+}
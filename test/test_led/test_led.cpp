@@ -6,9 +6,20 @@
  * All modification must get authorization from the author.
  */
 #include "../test_base.h"
+#include "core/timer/VirtualClock.h"
 #include "gfx/StatusLed.h"
 
 using namespace obd::gfx;
+using obd::core::timer::VirtualClock;
+
+/**
+ * @brief Let some virtual time pass, then run a frame
+ * @param duration The time to elapse in microseconds
+ */
+void elapse(uint64_t duration) {
+    VirtualClock::advance(duration);
+    baseSys.update();
+}
 
 void test_bad_init() {
     StatusLed led(nullptr);
@@ -21,104 +32,83 @@ void test_bad_init() {
 
 void test_solid_blink(){
     using obd::core::driver::Message;
+    VirtualClock::enable();
+    baseSys.update();
     auto led = baseSys.getNode<StatusLed>();
     TEST_ASSERT_NOT_NULL(led);
-    TEST_ASSERT(led->pushMessage(Message{0,led->type(),"led off",Message::MessageType::Command}))
+    TEST_ASSERT(led->pushMessage(Message{0,led->id(),"led off",Message::MessageType::Command}))
     led->update();
     TEST_ASSERT_EQUAL(LedState::Off, led->state());
-    TEST_ASSERT(led->pushMessage(Message{0,led->type(),"led solid",Message::MessageType::Command}))
+    TEST_ASSERT_FALSE(led->lit())
+    TEST_ASSERT(led->pushMessage(Message{0,led->id(),"led solid",Message::MessageType::Command}))
     led->update();
     TEST_ASSERT_EQUAL(LedState::Solid, led->state());
-    TEST_ASSERT(led->pushMessage(Message{0,led->type(),"led blink",Message::MessageType::Command}))
+    TEST_ASSERT(led->lit())
+    TEST_ASSERT(led->pushMessage(Message{0,led->id(),"led blink",Message::MessageType::Command}))
     led->update();
     TEST_ASSERT_EQUAL(LedState::Blink, led->state());
-    led->accelerateTime(obd::config::ledPeriod/2);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod);
-    led->update();
-    TEST_ASSERT_FALSE(led->pushMessage(Message{0,led->type(),"ledi",Message::MessageType::Command}))
-    TEST_ASSERT(led->pushMessage(Message{0,led->type(),"led xmas",Message::MessageType::Command}))
-    led->update();
+    TEST_ASSERT(led->lit())
+    elapse(obd::config::ledPeriod/2);
+    TEST_ASSERT_FALSE(led->lit())
+    elapse(obd::config::ledPeriod);
+    TEST_ASSERT_FALSE(led->lit())
+    elapse(obd::config::ledPeriod/2);
+    TEST_ASSERT(led->lit())
+    TEST_ASSERT_FALSE(led->pushMessage(Message{0,led->id(),"ledi",Message::MessageType::Command}))
+    TEST_ASSERT(led->pushMessage(Message{0,led->id(),"led xmas",Message::MessageType::Command}))
+    led->update();
+    VirtualClock::disable();
 }
 
 void test_fast_blink(){
     using obd::core::driver::Message;
+    VirtualClock::enable();
+    baseSys.update();
     auto led = baseSys.getNode<StatusLed>();
     TEST_ASSERT_NOT_NULL(led);
-    TEST_ASSERT(led->pushMessage(Message{0,led->type(),"led fastblink",Message::MessageType::Command}))
+    TEST_ASSERT(led->pushMessage(Message{0,led->id(),"led fastblink",Message::MessageType::Command}))
     led->update();
     TEST_ASSERT_EQUAL(LedState::FastBlink, led->state());
-    led->accelerateTime(obd::config::ledPeriod/4);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/4);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/4);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/4);
-    led->update();
-    TEST_ASSERT(led->pushMessage(Message{0,led->type(),"led fasterblink",Message::MessageType::Command}))
+    // on, off, on, off by quarter of period
+    const bool fastBlink[] = {false, true, false, true};
+    for (bool light : fastBlink) {
+        elapse(obd::config::ledPeriod/4);
+        TEST_ASSERT_EQUAL(light, led->lit());
+    }
+    TEST_ASSERT(led->pushMessage(Message{0,led->id(),"led fasterblink",Message::MessageType::Command}))
     led->update();
     TEST_ASSERT_EQUAL(LedState::FasterBlink, led->state());
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
+    for (uint8_t step = 1; step <= 8; ++step) {
+        elapse(obd::config::ledPeriod/8);
+        TEST_ASSERT_EQUAL(step % 2 == 0, led->lit());
+    }
+    VirtualClock::disable();
 }
 
 void test_pulse(){
     using obd::core::driver::Message;
+    VirtualClock::enable();
+    baseSys.update();
     auto led = baseSys.getNode<StatusLed>();
     TEST_ASSERT_NOT_NULL(led);
-    TEST_ASSERT(led->pushMessage(Message{0,led->type(),"led twopulse",Message::MessageType::Command}))
+    TEST_ASSERT(led->pushMessage(Message{0,led->id(),"led twopulse",Message::MessageType::Command}))
     led->update();
     TEST_ASSERT_EQUAL(LedState::TwoPulse, led->state());
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    TEST_ASSERT(led->pushMessage(Message{0,led->type(),"led threepulse",Message::MessageType::Command}))
+    // lights from the second eighth of period to the start of the next period
+    const bool twoPulses[] = {false, true, false, false, false, false, false, true};
+    for (bool light : twoPulses) {
+        elapse(obd::config::ledPeriod/8);
+        TEST_ASSERT_EQUAL(light, led->lit());
+    }
+    TEST_ASSERT(led->pushMessage(Message{0,led->id(),obd::core::driver::Command{StatusLed::Commands::Led, static_cast<uint8_t>(LedState::ThreePulses)}}))
     led->update();
     TEST_ASSERT_EQUAL(LedState::ThreePulses, led->state());
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
-    led->accelerateTime(obd::config::ledPeriod/8);
-    led->update();
+    const bool threePulses[] = {false, true, false, true, false, false, false, true};
+    for (bool light : threePulses) {
+        elapse(obd::config::ledPeriod/8);
+        TEST_ASSERT_EQUAL(light, led->lit());
+    }
+    VirtualClock::disable();
 }
 
 void test_all() {
@@ -0,0 +1,87 @@
+/**
+ * @file test_memory.cpp
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+#include "../test_base.h"
+#include "core/driver/Manager.h"
+#include "core/driver/Messenger.h"
+#include "core/memory/MemoryTracker.h"
+#include <vector>
+
+using namespace obd::core::memory;
+
+void test_tracker() {
+    Usage before      = Tracker::usage(5);
+    Usage totalBefore = Tracker::total();
+    int* data         = nullptr;
+    {
+        Scope scope{5};
+        TEST_ASSERT_EQUAL(5, Tracker::owner());
+        data = new int[100];
+    }
+    TEST_ASSERT_EQUAL(0, Tracker::owner());
+    TEST_ASSERT_EQUAL(before.live + 400, Tracker::usage(5).live);
+    TEST_ASSERT_EQUAL(before.allocations + 1, Tracker::usage(5).allocations);
+    TEST_ASSERT(Tracker::usage(5).peak >= Tracker::usage(5).live)
+    TEST_ASSERT_EQUAL(totalBefore.live + 400, Tracker::total().live);
+    // released outside of the scope: still given back to its owner
+    delete[] data;
+    TEST_ASSERT_EQUAL(before.live, Tracker::usage(5).live);
+    TEST_ASSERT_EQUAL(totalBefore.live, Tracker::total().live);
+    Tracker::resetPeaks();
+    TEST_ASSERT_EQUAL(Tracker::usage(5).live, Tracker::usage(5).peak);
+    // the last slot is shared
+    TEST_ASSERT_EQUAL(&Tracker::usage(200), &Tracker::usage(obd::config::memoryOwners - 1));
+}
+
+/**
+ * @brief Node keeping memory at each run
+ */
+class LeakyNode : public obd::core::driver::Node {
+public:
+    explicit LeakyNode(std::shared_ptr<Messenger> msg) :
+        Node{std::move(msg)} {
+        setSchedule(1);
+    }
+
+protected:
+    void postTreatment() override {
+        kept.push_back(std::vector<uint8_t>(256));
+        std::vector<uint8_t> spike(4096);
+        spike[0] = 1;
+    }
+
+private:
+    /// The kept memory
+    std::vector<std::vector<uint8_t>> kept;
+};
+
+void test_nodeUsage() {
+    using namespace obd::core::driver;
+    std::shared_ptr<Manager> mng   = std::make_shared<Manager>();
+    std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(mng);
+    auto node                      = std::make_shared<LeakyNode>(msg);
+    mng->addNode(node);
+    mng->init();
+    int64_t start = node->memoryUsage().live;
+    for (int i = 0; i < 4; ++i) {
+        delay(1);
+        mng->update();
+    }
+    TEST_ASSERT_EQUAL(4, node->schedule().runs);
+    // 4 kept blocks (and their list), the spike only in the peak
+    TEST_ASSERT(node->memoryUsage().live >= start + 4 * 256)
+    TEST_ASSERT(node->memoryUsage().live < start + 4096)
+    TEST_ASSERT(node->memoryUsage().peak >= node->memoryUsage().live + 4096)
+    TEST_ASSERT(node->memoryUsage().releases > 0)
+}
+
+void test_all() {
+    UNITY_BEGIN();
+    RUN_TEST(test_tracker);
+    RUN_TEST(test_nodeUsage);
+    UNITY_END();
+}
@@ -19,22 +19,22 @@ void test_command(){
 
     auto shell = baseSys.getNode<obd::com::Shell>();
     TEST_ASSERT_EQUAL(obd::core::driver::Category::Console, shell->category());
-    TEST_ASSERT(shell->pushMessage(obd::core::driver::Message{0,shell->type(),"hello world!",obd::core::driver::Message::MessageType::Message}));
+    TEST_ASSERT(shell->pushMessage(obd::core::driver::Message{0,shell->id(),"hello world!",obd::core::driver::Message::MessageType::Message}));
     baseSys.update();
     baseSys.update();
     TEST_ASSERT_EQUAL_STRING("All > hello world!\n", strCout.str().c_str());
     strCout.str("");
-    TEST_ASSERT(shell->pushMessage(obd::core::driver::Message{12,shell->type(),"hello world!",obd::core::driver::Message::MessageType::Warning}));
+    TEST_ASSERT(shell->pushMessage(obd::core::driver::Message{12,shell->id(),"hello world!",obd::core::driver::Message::MessageType::Warning}));
     baseSys.update();
     baseSys.update();
     TEST_ASSERT_EQUAL_STRING("Unknown > WARNING hello world!\n", strCout.str().c_str());
     strCout.str("");
-    TEST_ASSERT(shell->pushMessage(obd::core::driver::Message{0,shell->type(),"hello world!",obd::core::driver::Message::MessageType::Error}));
+    TEST_ASSERT(shell->pushMessage(obd::core::driver::Message{0,shell->id(),"hello world!",obd::core::driver::Message::MessageType::Error}));
     baseSys.update();
     baseSys.update();
     TEST_ASSERT_EQUAL_STRING("All > ERROR hello world!\n", strCout.str().c_str());
     strCout.str("");
-    TEST_ASSERT(shell->pushMessage(obd::core::driver::Message{0,shell->type(),"hello world!",obd::core::driver::Message::MessageType::Reply}));
+    TEST_ASSERT(shell->pushMessage(obd::core::driver::Message{0,shell->id(),"hello world!",obd::core::driver::Message::MessageType::Reply}));
     baseSys.update();
     baseSys.update();
     TEST_ASSERT_EQUAL_STRING("", strCout.str().c_str());
@@ -44,9 +44,76 @@ void test_command(){
     std::cout.rdbuf( oldCoutStreamBuf );
 }
 
+void test_top(){
+    std::streambuf* oldCoutStreamBuf = std::cout.rdbuf();
+    std::ostringstream strCout;
+    std::cout.rdbuf( strCout.rdbuf() );
+
+    auto shell = baseSys.getNode<obd::com::Shell>();
+    TEST_ASSERT(shell->pushMessage(obd::core::driver::Message{0,shell->id(),"top",obd::core::driver::Message::MessageType::Input}));
+    // one line per driver, until the last one
+    for (int i = 0; i < 20 && strCout.str().find("Stdout runs ") == std::string::npos; ++i)
+        baseSys.update();
+    std::string result = strCout.str();
+    TEST_ASSERT(result.find("Execution times in us") != std::string::npos)
+    TEST_ASSERT(result.find("StatusLed runs ") != std::string::npos)
+    TEST_ASSERT(result.find(" pre ") != std::string::npos)
+    TEST_ASSERT(shell->pushMessage(obd::core::driver::Message{0,shell->id(),"top reset",obd::core::driver::Message::MessageType::Input}));
+    baseSys.update();
+    TEST_ASSERT(shell->profile().preTreatment.count() <= 1)
+    baseSys.update();
+    baseSys.update();
+
+    // Restore old cout.
+    std::cout.rdbuf( oldCoutStreamBuf );
+}
+
+void test_truncated(){
+    std::streambuf* oldCoutStreamBuf = std::cout.rdbuf();
+    std::ostringstream strCout;
+    std::cout.rdbuf( strCout.rdbuf() );
+
+    auto shell = baseSys.getNode<obd::com::Shell>();
+    TEST_ASSERT(shell->pushMessage(obd::core::driver::Message{0,shell->id(),"help a b c d e f",obd::core::driver::Message::MessageType::Input}));
+    for (int i = 0; i < 3; ++i)
+        baseSys.update();
+    std::string result = strCout.str();
+
+    // Restore old cout.
+    std::cout.rdbuf( oldCoutStreamBuf );
+    TEST_ASSERT(result.find("ERROR Too many words in the command.") != std::string::npos)
+    TEST_ASSERT(result.find("Unknown command") == std::string::npos)
+}
+
+void test_mem(){
+    std::streambuf* oldCoutStreamBuf = std::cout.rdbuf();
+    std::ostringstream strCout;
+    std::cout.rdbuf( strCout.rdbuf() );
+
+    auto shell = baseSys.getNode<obd::com::Shell>();
+    TEST_ASSERT(shell->pushMessage(obd::core::driver::Message{0,shell->id(),"mem",obd::core::driver::Message::MessageType::Input}));
+    // one line per driver
+    for (int i = 0; i < 5; ++i)
+        baseSys.update();
+    std::string result = strCout.str();
+    TEST_ASSERT(result.find("Heap in bytes") != std::string::npos)
+    TEST_ASSERT(result.find("Shell > system ") != std::string::npos)
+    TEST_ASSERT(result.find("Shell > Stdout ") != std::string::npos)
+    TEST_ASSERT(result.find("Shell > total ") != std::string::npos)
+    TEST_ASSERT(shell->pushMessage(obd::core::driver::Message{0,shell->id(),"mem reset",obd::core::driver::Message::MessageType::Input}));
+    baseSys.update();
+    baseSys.update();
+
+    // Restore old cout.
+    std::cout.rdbuf( oldCoutStreamBuf );
+}
+
 void test_all() {
     UNITY_BEGIN();
     // tests one update
+    RUN_TEST(test_top);
+    RUN_TEST(test_mem);
+    RUN_TEST(test_truncated);
     RUN_TEST(test_command);
     UNITY_END();
 }
@@ -7,7 +7,11 @@
  */
 
 #include "../test_base.h"
+#include "core/StaticSystem.h"
 #include "core/System.h"
+#include "com/Stdout.h"
+#include "fs/FileSystem.h"
+#include "gfx/StatusLed.h"
 
 using namespace obd::core;
 
@@ -47,10 +51,53 @@ void test_addNode(){
     sys.update();
 }
 
+void test_staticSystem(){
+    using Static = StaticSystem<obd::gfx::StatusLed, obd::com::Shell, obd::com::Stdout>;
+    static_assert(Static::idOf<obd::com::Shell>() == 2);
+    static_assert(!Static::contains<MyNode>());
+    Static sys;
+    TEST_ASSERT_FALSE(sys.check());
+    sys.init();
+    TEST_ASSERT(sys.check());
+    TEST_ASSERT_EQUAL(3, sys.getManager().size());
+    TEST_ASSERT_EQUAL(Static::idOf<obd::gfx::StatusLed>(), sys.getNode<obd::gfx::StatusLed>().id());
+    TEST_ASSERT_EQUAL(Static::idOf<obd::com::Stdout>(), sys.getNode<obd::com::Stdout>().id());
+    TEST_ASSERT_EQUAL_STRING("Shell", sys.getMessenger().computeName(Static::idOf<obd::com::Shell>()).c_str());
+    // the communicators are the shell's outputs
+    TEST_ASSERT_EQUAL(1, sys.getMessenger().subscribers(driver::Topic::Log).size());
+    TEST_ASSERT_EQUAL(Static::idOf<obd::com::Stdout>(), sys.getMessenger().subscribers(driver::Topic::Log)[0]);
+    TEST_ASSERT(sys.getNode<obd::com::Shell>().pushMessage(driver::Message{0, Static::idOf<obd::com::Shell>(), "info", driver::Message::MessageType::Command}))
+    sys.update();
+    sys.update();
+    TEST_ASSERT_EQUAL(0, sys.getMessenger().stats().droppedMessage);
+}
+
+void test_staticFileSystem() {
+    using Static = StaticSystem<obd::com::Shell, obd::com::Stdout, obd::fs::FileSystem>;
+    Static sys;
+    sys.init();
+    TEST_ASSERT(sys.check());
+    auto& fileSystem = sys.getNode<obd::fs::FileSystem>();
+    TEST_ASSERT(fileSystem.initialized());
+    // the static nodes have no owner: nothing may ask for a shared pointer to them
+    obd::fs::Path path{"/static_touch.txt"};
+    TEST_ASSERT(fileSystem.touch(path))
+    TEST_ASSERT(fileSystem.isFile(path))
+    TEST_ASSERT(fileSystem.rm(path))
+    // the frame runs the nodes: the info reply reaches the shell
+    TEST_ASSERT(fileSystem.pushMessage(driver::Message{Static::idOf<obd::com::Shell>(), Static::idOf<obd::fs::FileSystem>(), "info", driver::Message::MessageType::Command}))
+    TEST_ASSERT_EQUAL(1, fileSystem.queueSize());
+    sys.update();
+    TEST_ASSERT_EQUAL(0, fileSystem.queueSize());
+    TEST_ASSERT_EQUAL(1, fileSystem.schedule().runs);
+}
+
 void test_all() {
     UNITY_BEGIN();
     // tests one update
     RUN_TEST(test_creation);
     RUN_TEST(test_addNode);
+    RUN_TEST(test_staticSystem);
+    RUN_TEST(test_staticFileSystem);
     UNITY_END();
 }
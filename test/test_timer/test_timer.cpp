@@ -0,0 +1,181 @@
+/**
+ * @file test_timer.cpp
+ * @author argawaen
+ * @date 18/10/2026
+ * Copyright © 2022 All rights reserved.
+ * All modification must get authorization from the author.
+ */
+#include "../test_base.h"
+#include "core/driver/Manager.h"
+#include "core/driver/Messenger.h"
+#include "core/timer/TimerService.h"
+#include "core/timer/VirtualClock.h"
+
+using namespace obd::core::timer;
+
+void test_virtualClock() {
+    VirtualClock::enable();
+    TEST_ASSERT(VirtualClock::enabled())
+    uint64_t start = now();
+    delay(2);
+    TEST_ASSERT_EQUAL(start, now());
+    VirtualClock::advance(1234);
+    TEST_ASSERT_EQUAL(start + 1234, now());
+    // no real wait in virtual time
+    idle(1000000);
+    TEST_ASSERT_EQUAL(start + 1234, now());
+    VirtualClock::disable();
+    TEST_ASSERT_FALSE(VirtualClock::enabled())
+}
+
+void test_oneShot() {
+    VirtualClock::enable();
+    TimerService timers;
+    auto id = timers.start(5000);
+    TEST_ASSERT(timers.running(id))
+    TEST_ASSERT_EQUAL(1, timers.size());
+    VirtualClock::advance(4000);
+    timers.advance(now());
+    TEST_ASSERT_EQUAL(0, timers.consume(id));
+    VirtualClock::advance(1000);
+    timers.advance(now());
+    TEST_ASSERT_FALSE(timers.running(id))
+    TEST_ASSERT_EQUAL(0, timers.size());
+    TEST_ASSERT_EQUAL(1, timers.consume(id));
+    // released once read
+    TEST_ASSERT_EQUAL(0, timers.consume(id));
+    TEST_ASSERT_FALSE(timers.stop(id))
+    VirtualClock::disable();
+}
+
+void test_periodic() {
+    VirtualClock::enable();
+    TimerService timers;
+    auto id = timers.start(10000, 10000);
+    VirtualClock::advance(35000);
+    timers.advance(now());
+    TEST_ASSERT_EQUAL(3, timers.consume(id));
+    TEST_ASSERT(timers.running(id))
+    VirtualClock::advance(5000);
+    timers.advance(now());
+    TEST_ASSERT_EQUAL(1, timers.consume(id));
+    TEST_ASSERT(timers.stop(id))
+    TEST_ASSERT_EQUAL(0, timers.size());
+    VirtualClock::disable();
+}
+
+void test_levels() {
+    VirtualClock::enable();
+    TimerService timers;
+    // one timer per level of the wheel, and one beyond its span (about 4.6 hours)
+    const uint64_t delays[] = {63000, 100000, 5000000, 300000000, 20000000000};
+    TimerService::TimerId ids[5];
+    for (size_t idx = 0; idx < 5; ++idx)
+        ids[idx] = timers.start(delays[idx]);
+    uint64_t start   = now();
+    uint64_t elapsed = 0;
+    for (size_t idx = 0; idx < 5; ++idx) {
+        // one tick before the expiry: nothing
+        timers.advance(start + delays[idx] - obd::config::timerTick);
+        TEST_ASSERT_EQUAL(0, timers.consume(ids[idx]));
+        timers.advance(start + delays[idx]);
+        TEST_ASSERT_EQUAL(1, timers.consume(ids[idx]));
+        elapsed = delays[idx];
+    }
+    VirtualClock::advance(elapsed);
+    TEST_ASSERT_EQUAL(0, timers.size());
+    VirtualClock::disable();
+}
+
+/// Amount of callback calls
+uint8_t callbackCount = 0;
+
+/**
+ * @brief Count the calls
+ */
+void countCallback(void* /*context*/) { ++callbackCount; }
+
+void test_stop() {
+    VirtualClock::enable();
+    TimerService timers;
+    int owner = 0;
+    callbackCount = 0;
+    auto first    = timers.start(2000, 0, &countCallback, &owner);
+    timers.start(3000, 1000, &countCallback, &owner);
+    auto other = timers.start(2000, 0, &countCallback);
+    TEST_ASSERT(timers.stop(first))
+    timers.stopAll(&owner);
+    TEST_ASSERT_EQUAL(1, timers.size());
+    TEST_ASSERT(timers.idleTime() <= 2000)
+    VirtualClock::advance(10000);
+    timers.advance(now());
+    TEST_ASSERT_EQUAL(1, callbackCount);
+    TEST_ASSERT_EQUAL(1, timers.consume(other));
+    TEST_ASSERT_EQUAL(UINT64_MAX, timers.idleTime());
+    // the pool is limited
+    for (uint8_t idx = 0; idx < obd::config::timerCount; ++idx)
+        TEST_ASSERT(timers.start(1000) != TimerService::invalidTimer)
+    TEST_ASSERT_EQUAL(TimerService::invalidTimer, timers.start(1000));
+    VirtualClock::disable();
+}
+
+/**
+ * @brief Node woken up by its timer only
+ */
+class TimedNode : public obd::core::driver::Node {
+public:
+    explicit TimedNode(std::shared_ptr<Messenger> msg) :
+        Node{std::move(msg)} {
+        setWakeups(obd::core::driver::Wakeup::Message);
+    }
+    void init() override {
+        Node::init();
+        tick = startTimer(100000, 100000);
+    }
+    /// Amount of expiries seen
+    uint16_t expiries = 0;
+
+protected:
+    void preTreatment() override { expiries += timerExpired(tick); }
+
+private:
+    /// The timer
+    TimerId tick = TimerService::invalidTimer;
+};
+
+void test_nodeTimer() {
+    using namespace obd::core::driver;
+    VirtualClock::enable();
+    std::shared_ptr<Manager> mng   = std::make_shared<Manager>();
+    std::shared_ptr<Messenger> msg = std::make_shared<Messenger>(mng);
+    auto node                      = std::make_shared<TimedNode>(msg);
+    mng->addNode(node);
+    mng->init();
+    mng->update();
+    TEST_ASSERT_EQUAL(0, node->schedule().runs);
+    TEST_ASSERT_EQUAL(1, mng->timerService().size());
+    VirtualClock::advance(99000);
+    TEST_ASSERT(mng->idleTime() > 0)
+    mng->update();
+    TEST_ASSERT_EQUAL(0, node->schedule().runs);
+    VirtualClock::advance(1000);
+    mng->update();
+    TEST_ASSERT_EQUAL(1, node->schedule().runs);
+    TEST_ASSERT_EQUAL(1, node->expiries);
+    VirtualClock::advance(250000);
+    mng->update();
+    TEST_ASSERT_EQUAL(2, node->schedule().runs);
+    TEST_ASSERT_EQUAL(3, node->expiries);
+    VirtualClock::disable();
+}
+
+void test_all() {
+    UNITY_BEGIN();
+    RUN_TEST(test_virtualClock);
+    RUN_TEST(test_oneShot);
+    RUN_TEST(test_periodic);
+    RUN_TEST(test_levels);
+    RUN_TEST(test_stop);
+    RUN_TEST(test_nodeTimer);
+    UNITY_END();
+}